@@ -0,0 +1,45 @@
+#include "case_insensitive_string.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <type_traits>
+
+// Compares compare and find of the locale-aware ci_char_traits against the
+// ASCII fast path in ascii_ci_char_traits, with the case-sensitive
+// std::char_traits as a baseline. The strings only differ in case, so compare
+// has to look at every character and find only hits the last one.
+
+using StdTraits = std::char_traits<char>;
+
+static std::string make_text(std::size_t size, bool upper) {
+  auto text = std::string(size, ' ');
+  for (std::size_t i = 0U; i < size; ++i)
+    text[i] = static_cast<char>((upper ? 'A' : 'a') + i % 26U);
+  return text;
+}
+
+template <typename Traits> static void BM_Compare(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto lhs = make_text(size, false);
+  // Case-sensitive traits would stop at the first character otherwise.
+  const auto rhs = make_text(size, !std::is_same_v<Traits, StdTraits>);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Traits::compare(lhs.data(), rhs.data(), size));
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Traits> static void BM_Find(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto text = std::string(size, 'a');
+  text.back() = 'b';
+  const auto needle = std::is_same_v<Traits, StdTraits> ? 'b' : 'B';
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Traits::find(text.data(), size, needle));
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Compare, StdTraits)->Range(16, 1 << 12);
+BENCHMARK_TEMPLATE(BM_Compare, ci_char_traits)->Range(16, 1 << 12);
+BENCHMARK_TEMPLATE(BM_Compare, ascii_ci_char_traits)->Range(16, 1 << 12);
+BENCHMARK_TEMPLATE(BM_Find, StdTraits)->Range(16, 1 << 12);
+BENCHMARK_TEMPLATE(BM_Find, ci_char_traits)->Range(16, 1 << 12);
+BENCHMARK_TEMPLATE(BM_Find, ascii_ci_char_traits)->Range(16, 1 << 12);
@@ -0,0 +1,71 @@
+#include "chapter11_generic_libraries.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+
+// Compares a hand-written loop against the sequential foreach, the parallel
+// foreach on a WorkStealingPool, which invokes the callable per element, and
+// foreach_batched, which hands it whole spans.
+
+static std::vector<int> make_values(std::size_t size) {
+  auto values = std::vector<int>(size);
+  std::iota(values.begin(), values.end(), 0);
+  return values;
+}
+
+static void update(int &i) { i = 3 * i + 1; }
+
+static void BM_Loop(benchmark::State &state) {
+  auto values = make_values(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (auto &value : values)
+      update(value);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Foreach(benchmark::State &state) {
+  auto values = make_values(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    foreach (values.begin(), values.end(), update)
+      ;
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ForeachPool(benchmark::State &state) {
+  auto pool = WorkStealingPool{};
+  auto values = make_values(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    foreach (pool, values.begin(), values.end(), [](int &i) { update(i); })
+      ;
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ForeachBatched(benchmark::State &state) {
+  auto pool = WorkStealingPool{};
+  auto values = make_values(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    foreach_batched(pool, values.begin(), values.end(), [](Span<int> batch) {
+      for (auto &value : batch)
+        update(value);
+    });
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Loop)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Foreach)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_ForeachPool)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22)
+    ->UseRealTime();
+BENCHMARK(BM_ForeachBatched)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22)
+    ->UseRealTime();
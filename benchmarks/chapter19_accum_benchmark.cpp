@@ -0,0 +1,71 @@
+#include "chapter20_overloading_on_type_properties.hpp"
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Compares the three ways accum sums a contiguous range: the scalar loop over
+// the policy, the SIMD kernel that traits permitting reassociation select,
+// and the parallel accum that splits the range over threads running the SIMD
+// kernel each.
+
+// Any policy other than SumPolicy keeps the scalar loop.
+struct ScalarSumPolicy {
+  template <typename T1, typename T2>
+  static void accumulate(T1 &total, const T2 &value) {
+    total += value;
+  }
+};
+
+template <typename T> static std::vector<T> make_values(std::size_t size) {
+  auto values = std::vector<T>(size);
+  std::iota(values.begin(), values.end(), T{});
+  return values;
+}
+
+template <typename T> static void BM_AccumScalar(benchmark::State &state) {
+  const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto total = accum<const T *, ScalarSumPolicy>(
+        values.data(), values.data() + values.size());
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> static void BM_AccumSimd(benchmark::State &state) {
+  const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto total =
+        accum<const T *, SumPolicy, ReassociatingAccumulationTraits<T>>(
+            values.data(), values.data() + values.size());
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T> static void BM_AccumParallel(benchmark::State &state) {
+  const auto values = make_values<T>(static_cast<std::size_t>(state.range(0)));
+  const auto threads = std::max(1U, std::thread::hardware_concurrency());
+  for (auto _ : state) {
+    auto total =
+        accum<const T *, SumPolicy, ReassociatingAccumulationTraits<T>>(
+            values.data(), values.data() + values.size(), threads);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The parallel accum runs on other threads, so wall time is what counts.
+#define BENCHMARK_ACCUM(Kernel, T)                                             \
+  BENCHMARK_TEMPLATE(Kernel, T)                                                \
+      ->RangeMultiplier(16)                                                    \
+      ->Range(1 << 8, 1 << 24)                                                 \
+      ->UseRealTime()
+
+BENCHMARK_ACCUM(BM_AccumScalar, int);
+BENCHMARK_ACCUM(BM_AccumSimd, int);
+BENCHMARK_ACCUM(BM_AccumParallel, int);
+BENCHMARK_ACCUM(BM_AccumScalar, float);
+BENCHMARK_ACCUM(BM_AccumSimd, float);
+BENCHMARK_ACCUM(BM_AccumParallel, float);
@@ -0,0 +1,105 @@
+#include "chapter20_overloading_on_type_properties.hpp"
+#include <benchmark/benchmark.h>
+#include <map>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Compares the Dictionary specializations against the standard containers
+// they replace: the Swiss table for hashable keys against std::unordered_map
+// and the sorted flat map for non-hashable keys (std::pair has no std::hash)
+// against std::map. Lookups hit in random order.
+
+using Point = std::pair<int, int>;
+
+static int make_key(int i, int) { return i * 7919; }
+static Point make_key(int i, Point) { return {i % 64, i}; }
+
+template <typename Map> using KeyOf = typename Map::key_type;
+
+template <typename Map> struct KeyType {
+  using Type = typename Map::key_type;
+};
+template <typename Key, typename Value, typename Allocator>
+struct KeyType<Dictionary<Key, Value, Allocator>> {
+  using Type = Key;
+};
+
+template <typename Map>
+static std::vector<typename KeyType<Map>::Type> make_keys(int size) {
+  auto keys = std::vector<typename KeyType<Map>::Type>{};
+  for (auto i = 0; i < size; ++i)
+    keys.push_back(make_key(i, typename KeyType<Map>::Type{}));
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{42U});
+  return keys;
+}
+
+template <typename Map> static void BM_Insert(benchmark::State &state) {
+  const auto keys = make_keys<Map>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    auto map = Map{};
+    for (const auto &key : keys)
+      map.try_emplace(key, 1);
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map> static bool found(Map &map, const KeyOf<Map> &key) {
+  return map.find(key) != map.end();
+}
+template <typename Key, typename Value, typename Allocator>
+static bool found(Dictionary<Key, Value, Allocator> &map, const Key &key) {
+  return map.find(key) != nullptr;
+}
+
+template <typename Map> static void BM_Find(benchmark::State &state) {
+  auto keys = make_keys<Map>(static_cast<int>(state.range(0)));
+  auto map = Map{};
+  for (const auto &key : keys)
+    map.try_emplace(key, 1);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{7U});
+  for (auto _ : state) {
+    auto hits = 0;
+    for (const auto &key : keys)
+      hits += found(map, key);
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Builds the dictionary in an arena that is released after every iteration.
+template <typename Key> static void BM_InsertArena(benchmark::State &state) {
+  using Allocator = ArenaAllocator<std::pair<Key, int>>;
+  const auto keys =
+      make_keys<Dictionary<Key, int>>(static_cast<int>(state.range(0)));
+  auto arena = Arena{};
+  for (auto _ : state) {
+    {
+      auto map = Dictionary<Key, int, Allocator>{Allocator{arena}};
+      for (const auto &key : keys)
+        map.try_emplace(key, 1);
+      benchmark::DoNotOptimize(map);
+    }
+    arena.release();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using SwissDictionary = Dictionary<int, int>;
+using UnorderedMap = std::unordered_map<int, int>;
+using SortedDictionary = Dictionary<Point, int>;
+using OrderedMap = std::map<Point, int>;
+
+BENCHMARK_TEMPLATE(BM_Insert, SwissDictionary)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_InsertArena, int)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Insert, UnorderedMap)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Find, SwissDictionary)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Find, UnorderedMap)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Insert, SortedDictionary)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_InsertArena, Point)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_Insert, OrderedMap)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_Find, SortedDictionary)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Find, OrderedMap)->Range(1 << 8, 1 << 18);
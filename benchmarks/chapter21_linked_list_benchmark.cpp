@@ -0,0 +1,59 @@
+#include "chapter21_templates_and_inheritance.hpp"
+#include <benchmark/benchmark.h>
+#include <forward_list>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Compares insertion into and traversal of std::forward_list against the pool
+// allocated and the unrolled linked list. All lists are filled by push_front, as
+// that is the only insertion std::forward_list and PooledLinkedList share
+// without knowing a position.
+
+using StdForwardList = std::forward_list<int>;
+using PooledList = PooledLinkedList<int>;
+using UnrolledList = UnrolledLinkedList<int>;
+
+template <typename List> static void BM_PushFront(benchmark::State &state) {
+  const auto size = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    auto list = List{};
+    for (auto i = 0; i < size; ++i)
+      list.push_front(i);
+    benchmark::DoNotOptimize(list.front());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Interleaves the insertions with allocations of random size that are freed
+// afterwards, which leaves the nodes scattered over the heap as they would be
+// in a long-running program.
+template <typename List> static List make_fragmented(int size) {
+  auto rng = std::mt19937{42U};
+  auto bytes = std::uniform_int_distribution<std::size_t>{8U, 256U};
+  auto garbage = std::vector<std::unique_ptr<char[]>>{};
+  auto list = List{};
+  for (auto i = 0; i < size; ++i) {
+    list.push_front(i);
+    garbage.push_back(std::make_unique<char[]>(bytes(rng)));
+  }
+  return list;
+}
+
+template <typename List> static void BM_Traverse(benchmark::State &state) {
+  const auto size = static_cast<int>(state.range(0));
+  auto list = make_fragmented<List>(size);
+  for (auto _ : state) {
+    auto sum = std::accumulate(list.begin(), list.end(), 0LL);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_TEMPLATE(BM_PushFront, StdForwardList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_PushFront, PooledList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_PushFront, UnrolledList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Traverse, StdForwardList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Traverse, PooledList)->Range(1 << 8, 1 << 18);
+BENCHMARK_TEMPLATE(BM_Traverse, UnrolledList)->Range(1 << 8, 1 << 18);
@@ -0,0 +1,60 @@
+#include "chapter22_bridging_static_and_dynamic_polymorphism.hpp"
+#include <any>
+#include <benchmark/benchmark.h>
+
+// Compares Any against std::any for a value that both hold inline (int) and a
+// value of three pointers that only Any holds inline.
+
+struct ThreePointers {
+  void *a{nullptr};
+  void *b{nullptr};
+  void *c{nullptr};
+};
+
+template <typename T, typename AnyT> const T &get(const AnyT &any) {
+  if constexpr (std::is_same_v<AnyT, std::any>)
+    return *std::any_cast<T>(&any);
+  else
+    return any.template get_value<T>();
+}
+
+template <typename AnyT, typename T>
+static void BM_Construct(benchmark::State &state) {
+  auto value = T{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&value);
+    auto any = AnyT{value};
+    benchmark::DoNotOptimize(any);
+  }
+}
+
+template <typename AnyT, typename T>
+static void BM_Copy(benchmark::State &state) {
+  const auto any = AnyT{T{}};
+  for (auto _ : state) {
+    auto copy = AnyT{any};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+template <typename AnyT, typename T>
+static void BM_GetValue(benchmark::State &state) {
+  const auto any = AnyT{T{}};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&any);
+    benchmark::DoNotOptimize(&get<T>(any));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Construct, std::any, int);
+BENCHMARK_TEMPLATE(BM_Construct, Any, int);
+BENCHMARK_TEMPLATE(BM_Construct, std::any, ThreePointers);
+BENCHMARK_TEMPLATE(BM_Construct, Any, ThreePointers);
+BENCHMARK_TEMPLATE(BM_Copy, std::any, int);
+BENCHMARK_TEMPLATE(BM_Copy, Any, int);
+BENCHMARK_TEMPLATE(BM_Copy, std::any, ThreePointers);
+BENCHMARK_TEMPLATE(BM_Copy, Any, ThreePointers);
+BENCHMARK_TEMPLATE(BM_GetValue, std::any, int);
+BENCHMARK_TEMPLATE(BM_GetValue, Any, int);
+BENCHMARK_TEMPLATE(BM_GetValue, std::any, ThreePointers);
+BENCHMARK_TEMPLATE(BM_GetValue, Any, ThreePointers);
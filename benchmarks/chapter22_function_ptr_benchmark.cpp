@@ -0,0 +1,48 @@
+#include "chapter22_bridging_static_and_dynamic_polymorphism.hpp"
+#include <benchmark/benchmark.h>
+#include <functional>
+
+// Compares the virtual and table-based dispatch policies of FunctionPtr
+// against std::function for a small closure that is stored inline by all three.
+
+template <typename Function> static void BM_Construct(benchmark::State &state) {
+  auto offset = 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&offset);
+    auto f = Function{[offset](int i) { return i + offset; }};
+    benchmark::DoNotOptimize(f);
+  }
+}
+
+template <typename Function> static void BM_Copy(benchmark::State &state) {
+  auto offset = 1;
+  const auto f = Function{[offset](int i) { return i + offset; }};
+  for (auto _ : state) {
+    auto copy = Function{f};
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+template <typename Function> static void BM_Invoke(benchmark::State &state) {
+  auto offset = 1;
+  const auto f = Function{[offset](int i) { return i + offset; }};
+  auto i = 0;
+  for (auto _ : state) {
+    i = f(i);
+    benchmark::DoNotOptimize(i);
+  }
+}
+
+using StdFunction = std::function<int(int)>;
+using VirtualFunctionPtr = FunctionPtr<int(int), VirtualDispatch>;
+using TableFunctionPtr = FunctionPtr<int(int), TableDispatch>;
+
+BENCHMARK_TEMPLATE(BM_Construct, StdFunction);
+BENCHMARK_TEMPLATE(BM_Construct, VirtualFunctionPtr);
+BENCHMARK_TEMPLATE(BM_Construct, TableFunctionPtr);
+BENCHMARK_TEMPLATE(BM_Copy, StdFunction);
+BENCHMARK_TEMPLATE(BM_Copy, VirtualFunctionPtr);
+BENCHMARK_TEMPLATE(BM_Copy, TableFunctionPtr);
+BENCHMARK_TEMPLATE(BM_Invoke, StdFunction);
+BENCHMARK_TEMPLATE(BM_Invoke, VirtualFunctionPtr);
+BENCHMARK_TEMPLATE(BM_Invoke, TableFunctionPtr);
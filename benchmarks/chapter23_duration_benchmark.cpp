@@ -0,0 +1,100 @@
+#include "chapter23_metaprogramming.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <ratio>
+#include <vector>
+
+// Compares the batch conversion of Durations between units against converting
+// std::chrono durations one by one with std::transform, and the expression
+// template sum of mixed units against the pairwise sum of std::chrono.
+
+// Samples in microseconds converted to nanoseconds (an integral factor) and to
+// milliseconds (a division).
+template <typename T, typename ToUnit>
+static void BM_ConvertDurations(benchmark::State &state) {
+  using FromUnit = Ratio<1, 1000000>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto samples = std::vector<Duration<T, FromUnit>>(size, T{12345});
+  auto converted = std::vector<Duration<T, ToUnit>>(size);
+  for (auto _ : state) {
+    convert_durations(samples.data(), samples.data() + size, converted.data());
+    benchmark::DoNotOptimize(converted.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T, typename ToPeriod>
+static void BM_ConvertChrono(benchmark::State &state) {
+  using FromDuration = std::chrono::duration<T, std::micro>;
+  using ToDuration = std::chrono::duration<T, ToPeriod>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+  auto samples = std::vector<FromDuration>(size, FromDuration{12345});
+  auto converted = std::vector<ToDuration>(size);
+  for (auto _ : state) {
+    std::transform(samples.begin(), samples.end(), converted.begin(),
+                   [](FromDuration d) {
+                     return std::chrono::duration_cast<ToDuration>(d);
+                   });
+    benchmark::DoNotOptimize(converted.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using Microseconds = Ratio<1, 1000000>;
+using Nanoseconds = Ratio<1, 1000000000>;
+using Milliseconds = Ratio<1, 1000>;
+
+BENCHMARK_TEMPLATE(BM_ConvertDurations, std::int64_t, Nanoseconds)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ConvertChrono, std::int64_t, std::nano)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ConvertDurations, std::int32_t, Milliseconds)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ConvertChrono, std::int32_t, std::milli)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ConvertDurations, double, Milliseconds)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ConvertChrono, double, std::milli)
+    ->Range(1 << 10, 1 << 20);
+
+// Sums samples in seconds, milliseconds, microseconds and minutes element by
+// element.
+static void BM_SumDurations(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto s = std::vector<Duration<std::int64_t>>(size, 1);
+  const auto ms = std::vector<Duration<std::int64_t, Milliseconds>>(size, 2);
+  const auto us = std::vector<Duration<std::int64_t, Microseconds>>(size, 3);
+  const auto min = std::vector<Duration<std::int64_t, Ratio<60>>>(size, 4);
+  auto sums = std::vector<Duration<std::int64_t, Microseconds>>(size);
+  for (auto _ : state) {
+    for (std::size_t i = 0U; i < size; ++i)
+      sums[i] = s[i] + ms[i] + us[i] + min[i];
+    benchmark::DoNotOptimize(sums.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SumChrono(benchmark::State &state) {
+  using namespace std::chrono;
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto s = std::vector<seconds>(size, seconds{1});
+  const auto ms = std::vector<milliseconds>(size, milliseconds{2});
+  const auto us = std::vector<microseconds>(size, microseconds{3});
+  const auto min = std::vector<minutes>(size, minutes{4});
+  auto sums = std::vector<microseconds>(size);
+  for (auto _ : state) {
+    for (std::size_t i = 0U; i < size; ++i)
+      sums[i] = s[i] + ms[i] + us[i] + min[i];
+    benchmark::DoNotOptimize(sums.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SumDurations)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SumChrono)->Range(1 << 10, 1 << 20);
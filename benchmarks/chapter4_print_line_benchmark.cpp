@@ -0,0 +1,63 @@
+#include "chapter4_variadic_templates.hpp"
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <streambuf>
+
+// Compares printing a typical log line through the operator<< fold of
+// variadic_print_line against formatting it into a stack buffer with
+// print_line, synchronously and through AsyncLineSink. Output is discarded
+// so that only formatting and the hand-off to the stream are measured.
+
+class NullBuffer : public std::streambuf {
+protected:
+  std::streamsize xsputn(const char *, std::streamsize count) override {
+    return count;
+  }
+  int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+};
+
+class DiscardCout {
+public:
+  DiscardCout() : previous{std::cout.rdbuf(&buffer)} {}
+  ~DiscardCout() { std::cout.rdbuf(previous); }
+
+private:
+  NullBuffer buffer{};
+  std::streambuf *previous;
+};
+
+static void BM_VariadicPrintLine(benchmark::State &state) {
+  const auto discard = DiscardCout{};
+  auto i = 0;
+  for (auto _ : state) {
+    ++i;
+    variadic_print_line("request", i, "took", 0.25 * i, "ms");
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariadicPrintLine);
+
+static void BM_PrintLine(benchmark::State &state) {
+  const auto discard = DiscardCout{};
+  auto i = 0;
+  for (auto _ : state) {
+    ++i;
+    print_line("request", i, "took", 0.25 * i, "ms");
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PrintLine);
+
+static void BM_AsyncPrintLine(benchmark::State &state) {
+  auto buffer = NullBuffer{};
+  auto os = std::ostream{&buffer};
+  auto sink = AsyncLineSink{os};
+  auto i = 0;
+  for (auto _ : state) {
+    ++i;
+    sink.print_line("request", i, "took", 0.25 * i, "ms");
+  }
+  sink.flush();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AsyncPrintLine);
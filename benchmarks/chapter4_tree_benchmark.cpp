@@ -0,0 +1,73 @@
+#include "chapter4_variadic_templates.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// Compares searches in a sorted array (std::lower_bound) against the same
+// values in EytzingerTree, one lookup at a time and in interleaved batches.
+// The keys are random, so that large trees miss the cache on most levels.
+
+static constexpr std::size_t Lookups = 4096U;
+
+static std::vector<int> make_sorted(std::size_t size) {
+  auto values = std::vector<int>(size);
+  for (std::size_t i = 0U; i < size; ++i)
+    values[i] = static_cast<int>(2U * i);
+  return values;
+}
+
+static std::vector<int> make_keys(std::size_t size) {
+  auto rng = std::mt19937{42U};
+  auto dist =
+      std::uniform_int_distribution<int>{0, static_cast<int>(2U * size)};
+  auto keys = std::vector<int>(Lookups);
+  for (auto &key : keys)
+    key = dist(rng);
+  return keys;
+}
+
+static void BM_SortedLowerBound(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto values = make_sorted(size);
+  const auto keys = make_keys(size);
+  for (auto _ : state) {
+    for (const auto key : keys)
+      benchmark::DoNotOptimize(
+          std::lower_bound(values.begin(), values.end(), key));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(Lookups));
+}
+BENCHMARK(BM_SortedLowerBound)->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+
+static void BM_EytzingerLowerBound(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto values = make_sorted(size);
+  const auto tree = EytzingerTree<int>{values.begin(), values.end()};
+  const auto keys = make_keys(size);
+  for (auto _ : state) {
+    for (const auto key : keys)
+      benchmark::DoNotOptimize(tree.lower_bound(key));
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(Lookups));
+}
+BENCHMARK(BM_EytzingerLowerBound)->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+
+static void BM_EytzingerLowerBoundBatch(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto values = make_sorted(size);
+  const auto tree = EytzingerTree<int>{values.begin(), values.end()};
+  const auto keys = make_keys(size);
+  auto bounds = std::vector<EytzingerTree<int>::Cursor>(Lookups, tree.end());
+  for (auto _ : state) {
+    tree.lower_bound_batch(keys.data(), keys.size(), bounds.data());
+    benchmark::DoNotOptimize(bounds.data());
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          static_cast<std::int64_t>(Lookups));
+}
+BENCHMARK(BM_EytzingerLowerBoundBatch)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 24);
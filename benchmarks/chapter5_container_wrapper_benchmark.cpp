@@ -0,0 +1,71 @@
+#include "chapter5_tricky_basics.hpp"
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Compares the converting assignment of ContainerWrapper, which assigns over
+// existing elements, against clearing the target and inserting all elements
+// again, which it used to do. The target already holds as many elements as
+// the source, as when the same wrapper is assigned repeatedly.
+
+template <typename T, template <typename, typename> class Container>
+struct Wrapped {
+  using Type = ContainerWrapper<T, Container>;
+  using Data = Container<T, std::allocator<T>>;
+};
+
+template <typename T> static T make_value(int i) { return static_cast<T>(i); }
+template <> std::string make_value<std::string>(int i) {
+  return std::string(24U, static_cast<char>('a' + i % 26));
+}
+
+template <typename Data> static Data make_data(std::size_t size) {
+  auto data = Data{};
+  for (std::size_t i = 0U; i < size; ++i)
+    data.push_back(make_value<typename Data::value_type>(static_cast<int>(i)));
+  return data;
+}
+
+template <typename Target, typename Source>
+static void BM_WrapperAssign(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto source =
+      typename Source::Type{make_data<typename Source::Data>(size)};
+  auto target = typename Target::Type{make_data<typename Target::Data>(size)};
+  for (auto _ : state) {
+    target = source;
+    benchmark::DoNotOptimize(target);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Target, typename Source>
+static void BM_ClearInsert(benchmark::State &state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto source = make_data<typename Source::Data>(size);
+  auto target = make_data<typename Target::Data>(size);
+  for (auto _ : state) {
+    target.clear();
+    target.insert(target.begin(), source.begin(), source.end());
+    benchmark::DoNotOptimize(target);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using IntVector = Wrapped<int, std::vector>;
+using IntDeque = Wrapped<int, std::deque>;
+using LongVector = Wrapped<long, std::vector>;
+using StringVector = Wrapped<std::string, std::vector>;
+using StringDeque = Wrapped<std::string, std::deque>;
+
+#define BENCHMARK_ASSIGNMENT(Target, Source)                                   \
+  BENCHMARK_TEMPLATE(BM_WrapperAssign, Target, Source)                         \
+      ->Range(1 << 6, 1 << 16);                                                \
+  BENCHMARK_TEMPLATE(BM_ClearInsert, Target, Source)->Range(1 << 6, 1 << 16)
+
+BENCHMARK_ASSIGNMENT(IntVector, IntDeque);
+BENCHMARK_ASSIGNMENT(IntDeque, IntVector);
+BENCHMARK_ASSIGNMENT(LongVector, IntVector);
+BENCHMARK_ASSIGNMENT(StringVector, StringDeque);
+BENCHMARK_ASSIGNMENT(StringDeque, StringVector);
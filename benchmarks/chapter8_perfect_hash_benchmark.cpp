@@ -0,0 +1,87 @@
+#include "chapter8_compile_time_programming.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compares keyword lookups in a compile-time perfect hash table against
+// std::unordered_map and a linear scan over the keywords. Half of the queries
+// are keywords, the other half are identifiers that are not.
+
+constexpr std::string_view keywords[] = {
+    "alignas", "alignof", "auto", "bool", "break", "case", "catch", "char",
+    "class", "const", "constexpr", "continue", "decltype", "default", "delete",
+    "do", "double", "else", "enum", "explicit", "extern", "false", "float",
+    "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+    "namespace", "new", "noexcept", "nullptr", "operator", "private",
+    "protected", "public", "return", "short", "signed", "sizeof", "static",
+    "struct", "switch", "template", "this", "throw", "true", "try", "typedef",
+    "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+    "while"};
+
+constexpr auto keyword_count = std::size(keywords);
+constexpr auto npos = static_cast<std::size_t>(-1);
+
+std::vector<std::string> make_queries() {
+  auto queries = std::vector<std::string>{};
+  for (const auto keyword : keywords) {
+    queries.emplace_back(keyword);
+    queries.emplace_back(std::string{keyword} + "_");
+  }
+  std::rotate(queries.begin(), queries.begin() + 7, queries.end());
+  return queries;
+}
+
+struct PerfectHashLookup {
+  static constexpr auto table = make_perfect_hash(keywords);
+  std::size_t operator()(std::string_view key) const {
+    return table.find(key);
+  }
+};
+
+struct CaseInsensitivePerfectHashLookup {
+  static constexpr auto table =
+      make_perfect_hash<CaseInsensitiveFold>(keywords);
+  std::size_t operator()(std::string_view key) const {
+    return table.find(key);
+  }
+};
+
+struct UnorderedMapLookup {
+  std::unordered_map<std::string_view, std::size_t> map{};
+  UnorderedMapLookup() {
+    for (std::size_t i = 0U; i < keyword_count; ++i)
+      map.emplace(keywords[i], i);
+  }
+  std::size_t operator()(std::string_view key) const {
+    const auto it = map.find(key);
+    return it == map.end() ? npos : it->second;
+  }
+};
+
+struct LinearScanLookup {
+  std::size_t operator()(std::string_view key) const {
+    for (std::size_t i = 0U; i < keyword_count; ++i) {
+      if (keywords[i] == key)
+        return i;
+    }
+    return npos;
+  }
+};
+
+template <typename Lookup> static void BM_Lookup(benchmark::State &state) {
+  const auto queries = make_queries();
+  const auto lookup = Lookup{};
+  for (auto _ : state) {
+    for (const auto &query : queries)
+      benchmark::DoNotOptimize(lookup(query));
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(queries.size()));
+}
+
+BENCHMARK_TEMPLATE(BM_Lookup, PerfectHashLookup);
+BENCHMARK_TEMPLATE(BM_Lookup, CaseInsensitivePerfectHashLookup);
+BENCHMARK_TEMPLATE(BM_Lookup, UnorderedMapLookup);
+BENCHMARK_TEMPLATE(BM_Lookup, LinearScanLookup);
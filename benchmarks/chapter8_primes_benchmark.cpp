@@ -0,0 +1,66 @@
+#include "chapter8_compile_time_programming.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+// Compares the trial division up to p / 2 of cpp14::is_prime against the
+// trial division up to sqrt(p) of primes::is_prime, and collecting all primes
+// below n by trial division against the segmented sieve. The compile-time
+// cost of the prime tests is measured by the compile_time_benchmarks target.
+
+struct HalfBoundIsPrime {
+  bool operator()(std::size_t p) const { return cpp14::is_prime(p); }
+};
+
+struct SqrtBoundIsPrime {
+  bool operator()(std::size_t p) const { return primes::is_prime(p); }
+};
+
+template <typename IsPrime> static void BM_IsPrime(benchmark::State &state) {
+  const auto first = static_cast<std::size_t>(state.range(0));
+  const auto is_prime = IsPrime{};
+  for (auto _ : state) {
+    for (auto p = first; p < first + 64U; ++p) {
+      benchmark::DoNotOptimize(p);
+      benchmark::DoNotOptimize(is_prime(p));
+    }
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * 64);
+}
+
+template <typename IsPrime>
+static void BM_PrimesBelowTrialDivision(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const auto is_prime = IsPrime{};
+  for (auto _ : state) {
+    auto primes = std::vector<std::size_t>{};
+    for (std::size_t p = 2U; p < n; ++p) {
+      if (is_prime(p))
+        primes.push_back(p);
+    }
+    benchmark::DoNotOptimize(primes.data());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+static void BM_PrimesBelowSegmentedSieve(benchmark::State &state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    auto primes = primes::primes_below(n);
+    benchmark::DoNotOptimize(primes.data());
+  }
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_IsPrime, HalfBoundIsPrime)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_IsPrime, SqrtBoundIsPrime)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_PrimesBelowTrialDivision, HalfBoundIsPrime)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_PrimesBelowTrialDivision, SqrtBoundIsPrime)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PrimesBelowSegmentedSieve)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 28);
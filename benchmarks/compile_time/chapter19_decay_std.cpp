@@ -0,0 +1,3 @@
+#include "chapter19_decay_workload.hpp"
+
+static_assert(decays<std::decay_t>(std::make_index_sequence<BENCHMARK_SIZE>{}));
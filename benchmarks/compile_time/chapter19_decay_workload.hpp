@@ -0,0 +1,23 @@
+#ifndef BENCHMARKS_COMPILE_TIME_CHAPTER19_DECAY_WORKLOAD
+#define BENCHMARKS_COMPILE_TIME_CHAPTER19_DECAY_WORKLOAD
+
+#include "chapter19_implementing_traits.hpp"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Decays BENCHMARK_SIZE distinct types in each of the shapes that decay:
+// cv-qualified types, arrays and functions.
+
+template <std::size_t I> struct Element {};
+
+template <template <typename> class Decay, std::size_t... Is>
+constexpr bool decays(std::index_sequence<Is...>) {
+  return ((std::is_same_v<Decay<const volatile Element<Is>>, Element<Is>> &&
+           std::is_same_v<Decay<Element<Is>[Is + 1U]>, Element<Is> *> &&
+           std::is_same_v<Decay<Element<Is>(Element<Is>)>,
+                          Element<Is> (*)(Element<Is>)>) &&
+          ...);
+}
+
+#endif // !BENCHMARKS_COMPILE_TIME_CHAPTER19_DECAY_WORKLOAD
@@ -0,0 +1,12 @@
+#include "chapter19_implementing_traits.hpp"
+
+// Checks with the HasPlus concept directly, compiled as C++20.
+
+#if !defined(__cpp_concepts)
+#error "Requires C++20 concepts"
+#endif
+
+template <typename T1, typename T2> constexpr bool Addable = HasPlus<T1, T2>;
+template <typename T1, typename T2> using Sum = PlusResult<T1, T2>;
+
+#include "chapter19_detection_workload.hpp"
@@ -0,0 +1,10 @@
+#include "chapter19_implementing_traits.hpp"
+
+// HasPlusT and PlusResult built on the detection idiom, with the std::void_t
+// probe in C++17 and the Detected concept in C++20.
+
+template <typename T1, typename T2>
+constexpr bool Addable = HasPlusT<T1, T2>::value;
+template <typename T1, typename T2> using Sum = PlusResult<T1, T2>;
+
+#include "chapter19_detection_workload.hpp"
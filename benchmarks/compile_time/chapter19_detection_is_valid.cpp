@@ -0,0 +1,15 @@
+#include "chapter19_implementing_traits.hpp"
+
+// Checks with a trait made by is_valid. It cannot yield the result type, so
+// Sum names the expression directly.
+
+constexpr auto has_plus =
+    is_valid([](auto &&x, auto &&y) -> decltype(x + y) {});
+
+template <typename T1, typename T2>
+constexpr bool Addable =
+    decltype(has_plus(std::declval<T1>(), std::declval<T2>()))::value;
+template <typename T1, typename T2>
+using Sum = decltype(std::declval<T1>() + std::declval<T2>());
+
+#include "chapter19_detection_workload.hpp"
@@ -0,0 +1,27 @@
+#include "chapter19_implementing_traits.hpp"
+
+// HasPlusT and PlusResultT as they were before the detection idiom. The
+// result trait probes the expression a second time.
+
+namespace previous {
+
+template <typename, typename, typename = std::void_t<>>
+struct HasPlusT : std::false_type {};
+template <typename T1, typename T2>
+struct HasPlusT<T1, T2,
+                std::void_t<decltype(std::declval<T1>() + std::declval<T2>())>>
+    : std::true_type {};
+
+template <typename T1, typename T2, bool = HasPlusT<T1, T2>::value>
+struct PlusResultT {
+  using Type = decltype(std::declval<T1>() + std::declval<T2>());
+};
+template <typename T1, typename T2> struct PlusResultT<T1, T2, false> {};
+} // namespace previous
+
+template <typename T1, typename T2>
+constexpr bool Addable = previous::HasPlusT<T1, T2>::value;
+template <typename T1, typename T2>
+using Sum = typename previous::PlusResultT<T1, T2>::Type;
+
+#include "chapter19_detection_workload.hpp"
@@ -0,0 +1,46 @@
+#ifndef BENCHMARKS_COMPILE_TIME_CHAPTER19_DETECTION_WORKLOAD
+#define BENCHMARKS_COMPILE_TIME_CHAPTER19_DETECTION_WORKLOAD
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// BENCHMARK_SIZE types of which every other one can be added to itself and to
+// int. Every variant defines Addable<T1, T2>, which checks for operator+, and
+// Sum<T1, T2>, the SFINAE-friendly type of T1 + T2, before including this
+// header. All types are checked with Addable and resolve an overload set that
+// is constrained on Addable and Sum.
+
+// The operators are members, so that every check only looks up the two of its
+// own type instead of all of them.
+template <std::size_t I> struct Element {
+  template <std::size_t J = I, typename = std::enable_if_t<J % 2U == 0U>>
+  Element operator+(Element) const;
+  template <std::size_t J = I, typename = std::enable_if_t<J % 2U == 0U>>
+  Element operator+(int) const;
+};
+
+// Checks for the operation before it uses its result, as the traits in
+// chapter 19 used to do in PlusResultT.
+template <typename T, typename = std::enable_if_t<Addable<T, int>>,
+          typename = Sum<T, int>>
+std::true_type adds_int(int);
+template <typename T> std::false_type adds_int(...);
+
+// Expands into an array rather than a fold expression, whose nesting alone
+// takes quadratic time to compile.
+template <std::size_t... Is>
+constexpr std::size_t count_additions(std::index_sequence<Is...>) {
+  constexpr std::size_t additions[] = {
+      (std::size_t{Addable<Element<Is>, Element<Is>>} +
+       decltype(adds_int<Element<Is>>(0))::value)...};
+  auto count = std::size_t{0U};
+  for (const auto addition : additions)
+    count += addition;
+  return count;
+}
+
+static_assert(count_additions(std::make_index_sequence<BENCHMARK_SIZE>{}) ==
+              (BENCHMARK_SIZE + 1U) / 2U * 2U);
+
+#endif // !BENCHMARKS_COMPILE_TIME_CHAPTER19_DETECTION_WORKLOAD
@@ -0,0 +1,17 @@
+#include "chapter23_metaprogramming.hpp"
+#include <type_traits>
+#include <utility>
+
+// The common unit of BENCHMARK_SIZE units of 1 to 7 ones, tenths, hundredths
+// and thousandths. CommonUnitT recurses once per unit and computes a gcd and
+// an lcm in every step.
+
+inline constexpr RatioValue Denominators[] = {1U, 10U, 100U, 1000U};
+
+template <std::size_t... Is>
+CommonUnit<Ratio<Is % 7U + 1U, Denominators[Is % 4U]>...>
+    common_unit(std::index_sequence<Is...>);
+
+using Common =
+    decltype(common_unit(std::make_index_sequence<BENCHMARK_SIZE>{}));
+static_assert(std::is_same_v<Common, Ratio<1U, 1000U>>);
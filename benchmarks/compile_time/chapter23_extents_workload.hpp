@@ -0,0 +1,21 @@
+#ifndef BENCHMARKS_COMPILE_TIME_CHAPTER23_EXTENTS_WORKLOAD
+#define BENCHMARKS_COMPILE_TIME_CHAPTER23_EXTENTS_WORKLOAD
+
+#include "chapter23_metaprogramming.hpp"
+#include <cstddef>
+#include <type_traits>
+
+// An array of unknown bound of arrays with BENCHMARK_SIZE - 1 extents in
+// total. Building it takes the same BENCHMARK_SIZE instantiations for every
+// implementation that removes the extents again.
+
+template <typename T, std::size_t N> struct AddExtentsT {
+  using Type = typename AddExtentsT<T, N - 1U>::Type[1];
+};
+template <typename T> struct AddExtentsT<T, 0U> {
+  using Type = T;
+};
+
+using Extents = typename AddExtentsT<int, BENCHMARK_SIZE - 1U>::Type[];
+
+#endif // !BENCHMARKS_COMPILE_TIME_CHAPTER23_EXTENTS_WORKLOAD
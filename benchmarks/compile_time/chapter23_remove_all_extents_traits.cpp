@@ -0,0 +1,3 @@
+#include "chapter23_extents_workload.hpp"
+
+static_assert(std::is_same_v<RemoveAllExtents<Extents>, int>);
@@ -0,0 +1,10 @@
+#include "chapter24_typelist_workload.hpp"
+
+// Looks up every element of the list.
+
+template <std::size_t... Is>
+constexpr std::size_t total_size(std::index_sequence<Is...>) {
+  return (std::size_t{0U} + ... + sizeof(flat::NthElement<Elements, Is>));
+}
+
+static_assert(total_size(std::make_index_sequence<BENCHMARK_SIZE>{}) > 0U);
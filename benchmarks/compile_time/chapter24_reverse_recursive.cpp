@@ -0,0 +1,4 @@
+#include "chapter24_typelist_workload.hpp"
+
+using Reversed = Reverse<Elements>;
+static_assert(sizeof(NthElement<Reversed, BENCHMARK_SIZE - 1U>) == 1U);
@@ -0,0 +1,3 @@
+#include "chapter24_typelist_workload.hpp"
+
+static_assert(sizeof(Front<flat::MergeSort<Elements, SmallerThanT>>) == 1U);
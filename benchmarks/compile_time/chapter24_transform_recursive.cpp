@@ -0,0 +1,4 @@
+#include "chapter24_typelist_workload.hpp"
+
+static_assert(sizeof(Front<Transform<Elements, PointerT>>) ==
+              sizeof(void *));
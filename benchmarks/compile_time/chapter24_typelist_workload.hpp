@@ -0,0 +1,28 @@
+#ifndef BENCHMARKS_COMPILE_TIME_CHAPTER24_TYPELIST_WORKLOAD
+#define BENCHMARKS_COMPILE_TIME_CHAPTER24_TYPELIST_WORKLOAD
+
+#include "chapter24_typelists.hpp"
+#include <cstddef>
+#include <utility>
+
+// A typelist of BENCHMARK_SIZE distinct types of varying sizes.
+
+template <std::size_t I> struct Element {
+  char data[(I * 7U) % 13U + 1U];
+};
+
+template <std::size_t... Is>
+Typelist<Element<Is>...> make_elements(std::index_sequence<Is...>);
+
+using Elements =
+    decltype(make_elements(std::make_index_sequence<BENCHMARK_SIZE>{}));
+
+template <typename T, typename U> struct LargerT {
+  using Type = IfThenElse<(sizeof(T) >= sizeof(U)), T, U>;
+};
+
+template <typename T> struct PointerT {
+  using Type = T *;
+};
+
+#endif // !BENCHMARKS_COMPILE_TIME_CHAPTER24_TYPELIST_WORKLOAD
@@ -0,0 +1,12 @@
+#include "chapter8_compile_time_programming.hpp"
+
+// Counts the primes below BENCHMARK_SIZE with the constexpr trial division up
+// to p / 2.
+
+constexpr auto count = [] {
+  auto count = std::size_t{0U};
+  for (std::size_t p = 0U; p < BENCHMARK_SIZE; ++p)
+    count += cpp14::is_prime(p) ? 1U : 0U;
+  return count;
+}();
+static_assert(count > 0U);
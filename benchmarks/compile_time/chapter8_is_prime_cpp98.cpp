@@ -0,0 +1,14 @@
+#include "chapter8_compile_time_programming.hpp"
+#include <utility>
+
+// Counts the primes below BENCHMARK_SIZE with the recursive metafunction. Each
+// test instantiates P / 2 class templates.
+
+template <std::size_t... Is>
+constexpr std::size_t count_primes(std::index_sequence<Is...>) {
+  return (std::size_t{0U} + ... + (cpp98::is_prime<Is>::value ? 1U : 0U));
+}
+
+constexpr auto count =
+    count_primes(std::make_index_sequence<BENCHMARK_SIZE>{});
+static_assert(count > 0U);
@@ -0,0 +1,12 @@
+#include "chapter8_compile_time_programming.hpp"
+
+// Counts the primes below BENCHMARK_SIZE with the constexpr trial division up
+// to sqrt(p).
+
+constexpr auto count = [] {
+  auto count = std::size_t{0U};
+  for (std::size_t p = 0U; p < BENCHMARK_SIZE; ++p)
+    count += primes::is_prime(p) ? 1U : 0U;
+  return count;
+}();
+static_assert(count > 0U);
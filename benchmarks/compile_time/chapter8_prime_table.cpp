@@ -0,0 +1,5 @@
+#include "chapter8_compile_time_programming.hpp"
+
+// Computes all primes below BENCHMARK_SIZE with the constexpr sieve.
+
+static_assert(primes::PrimeTable<BENCHMARK_SIZE>.size() > 0U);
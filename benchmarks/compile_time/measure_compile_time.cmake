@@ -0,0 +1,94 @@
+# Compiles SOURCE with -DBENCHMARK_SIZE=SIZE and writes the wall time of the
+# compiler in milliseconds, the memory it allocated in kB and the number of
+# class template instantiations to OUTPUT as
+# "NAME;SIZE;MILLISECONDS;KILOBYTES;INSTANTIATIONS".
+#
+# GCC reports the memory it allocated for its garbage-collected data
+# structures, which hold all types and declarations, with -ftime-report and
+# the number of entries in its table of class template specializations with
+# -fmem-report. Collecting the statistics slows down the compiler, so they are
+# gathered in a second, untimed run.
+#
+# Clang does not report either, so the table shows "-" instead. It writes a
+# trace of where the time went with -ftime-trace though, which a third run
+# stores next to OUTPUT as a .json file that chrome://tracing or Perfetto
+# display. GCC has no such trace.
+#
+# Usage: cmake -DCOMPILER=... -DCOMPILER_ID=... -DFLAGS_FILE=... -DSOURCE=...
+#              -DNAME=... -DSIZE=... -DOUTPUT=... -P measure_compile_time.cmake
+#
+# FLAGS_FILE contains the compiler flags, one per line. The optional
+# EXTRA_FLAGS are appended to them.
+
+file(STRINGS ${FLAGS_FILE} FLAGS)
+list(APPEND FLAGS ${EXTRA_FLAGS})
+
+# %f, the microseconds, is only available since CMake 3.23. Older versions
+# measure whole seconds.
+if(CMAKE_VERSION VERSION_LESS 3.23)
+    set(timestamp_format "%s")
+    set(timestamp_to_milliseconds "* 1000")
+else()
+    set(timestamp_format "%s%f")
+    set(timestamp_to_milliseconds "/ 1000")
+endif()
+
+string(TIMESTAMP start "${timestamp_format}" UTC)
+execute_process(
+    COMMAND ${COMPILER} ${FLAGS} -DBENCHMARK_SIZE=${SIZE} ${SOURCE}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors)
+string(TIMESTAMP stop "${timestamp_format}" UTC)
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR
+        "Compiling ${NAME} with size ${SIZE} failed:\n${errors}")
+endif()
+
+math(EXPR milliseconds "(${stop} - ${start}) ${timestamp_to_milliseconds}")
+
+set(kilobytes "-")
+set(instantiations "-")
+if(COMPILER_ID STREQUAL "GNU")
+    execute_process(
+        COMMAND ${COMPILER} ${FLAGS} -ftime-report -fmem-report
+            -DBENCHMARK_SIZE=${SIZE} ${SOURCE}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_VARIABLE report)
+    if(result EQUAL 0)
+        # The last column of the TOTAL row, e.g. "109M" or "1187k".
+        string(REGEX MATCH "TOTAL[ \t]*:[^\n]* ([0-9]+)([kMG])[ \t]*\n"
+            match "${report}")
+        if(match)
+            set(kilobytes ${CMAKE_MATCH_1})
+            if(CMAKE_MATCH_2 STREQUAL "M")
+                math(EXPR kilobytes "${kilobytes} * 1024")
+            elseif(CMAKE_MATCH_2 STREQUAL "G")
+                math(EXPR kilobytes "${kilobytes} * 1024 * 1024")
+            endif()
+        endif()
+        string(REGEX MATCH
+            "type_specializations: size [0-9]+, ([0-9]+) elements"
+            match "${report}")
+        if(match)
+            set(instantiations ${CMAKE_MATCH_1})
+        endif()
+    endif()
+elseif(COMPILER_ID MATCHES "Clang")
+    # -ftime-trace names the trace after the object file, so this run has to
+    # produce one.
+    set(trace_flags ${FLAGS})
+    list(REMOVE_ITEM trace_flags -fsyntax-only)
+    get_filename_component(output_dir ${OUTPUT} DIRECTORY)
+    execute_process(
+        COMMAND ${COMPILER} ${trace_flags} -ftime-trace -c
+            -o ${output_dir}/${NAME}_${SIZE}.o -DBENCHMARK_SIZE=${SIZE}
+            ${SOURCE}
+        OUTPUT_QUIET
+        ERROR_QUIET)
+    file(REMOVE ${output_dir}/${NAME}_${SIZE}.o)
+endif()
+
+file(WRITE ${OUTPUT}
+    "${NAME};${SIZE};${milliseconds};${kilobytes};${instantiations}\n")
@@ -0,0 +1,41 @@
+# Prints the results written by measure_compile_time.cmake in RESULTS_DIR as a
+# table.
+#
+# Usage: cmake -DRESULTS_DIR=... -P report_compile_time.cmake
+
+# Appends the columns to out_table, the first one left-aligned and the others
+# right-aligned to the given widths.
+function(append_row out_table)
+    set(row "")
+    set(widths 46 8 12 14 16)
+    set(index 0)
+    foreach(column ${ARGN})
+        list(GET widths ${index} width)
+        string(LENGTH "${column}" length)
+        set(padding "")
+        if(length LESS width)
+            math(EXPR padding_length "${width} - ${length}")
+            string(REPEAT " " ${padding_length} padding)
+        endif()
+        if(index EQUAL 0)
+            string(APPEND row "${column}${padding}")
+        else()
+            string(APPEND row "${padding}${column}")
+        endif()
+        math(EXPR index "${index} + 1")
+    endforeach()
+    set(${out_table} "${${out_table}}${row}\n" PARENT_SCOPE)
+endfunction()
+
+file(GLOB result_files ${RESULTS_DIR}/*.result)
+list(SORT result_files COMPARE NATURAL)
+
+set(table "\n")
+append_row(table
+    "benchmark" "size" "time [ms]" "memory [kB]" "instantiations")
+foreach(result_file ${result_files})
+    file(READ ${result_file} line)
+    string(STRIP "${line}" line)
+    append_row(table ${line})
+endforeach()
+message("${table}")
@@ -1,4 +1,7 @@
 #include "chapter11_generic_libraries.hpp"
+#include <cassert>
+#include <list>
+#include <numeric>
 
 int main() {
   const auto fibonacci = std::vector<int>{1, 1, 2, 3, 5, 8, 13, 21};
@@ -32,5 +35,92 @@ int main() {
       "fib - ")
     ;
 
+  // Parallel foreach on a work-stealing thread pool.
+  auto pool = WorkStealingPool{4U};
+  auto numbers = std::vector<int>(10000U);
+  std::iota(numbers.begin(), numbers.end(), 0);
+  auto sum = std::atomic<long>{0};
+  foreach (pool, numbers.begin(), numbers.end(),
+           [&sum](int i) { sum.fetch_add(i, std::memory_order_relaxed); })
+    ;
+  assert(sum == 49995000);
+
+  // A pool asked for zero threads still gets one worker.
+  {
+    auto single = WorkStealingPool{0U};
+    assert(single.size() == 1U);
+    sum = 0;
+    foreach (single, numbers.begin(), numbers.end(),
+             [&sum](int i) { sum.fetch_add(i, std::memory_order_relaxed); })
+      ;
+    assert(sum == 49995000);
+  }
+
+  // Extra arguments are bound like with the sequential foreach while forward
+  // iterators fall back to the sequential foreach.
+  const auto list = std::list<int>(numbers.begin(), numbers.end());
+  sum = 0;
+  foreach (
+      pool, list.begin(), list.end(),
+      [](std::atomic<long> *sum, int i) { sum->fetch_add(i); }, &sum)
+    ;
+  assert(sum == 49995000);
+
+  // Batched foreach hands contiguous spans to the callable.
+  foreach_batched(pool, numbers.begin(), numbers.end(), [](Span<int> batch) {
+    for (auto &i : batch)
+      i *= 2;
+  });
+  assert(numbers[4999] == 9998);
+
+  // Structure of arrays: a loop over one field only touches its column.
+  using Particle = Typelist<float, float, int, std::string>;
+  auto particles = SoAVector<Particle>{};
+  for (auto i = 0; i < 1000; ++i)
+    particles.emplace_back(static_cast<float>(i), 1.0F, i % 3,
+                           "particle " + std::to_string(i));
+  assert(particles.size() == 1000U && particles.capacity() >= 1000U);
+  const auto aligned = [](const void *column) {
+    return reinterpret_cast<std::uintptr_t>(column) % CacheLineSize == 0U;
+  };
+  assert(aligned(particles.column<0>().data()));
+  assert(aligned(particles.column<1>().data()));
+  assert(aligned(particles.column<2>().data()));
+  assert(aligned(particles.column<3>().data()));
+  const auto velocities = particles.column<1>();
+  assert((accum<const float *, SumPolicy>(velocities.begin(),
+                                          velocities.end()) == 1000.0F));
+  foreach_batched(pool, particles.column<0>().begin(),
+                  particles.column<0>().end(), [](Span<float> positions) {
+                    for (auto &position : positions)
+                      position += 0.5F;
+                  });
+  auto [position, velocity, group, name] = particles[999];
+  assert(position == 999.5F && velocity == 1.0F && group == 0);
+  assert(name == "particle 999");
+  group = 7;
+  assert(particles[999].get<2>() == 7);
+  // Arguments may alias fields of the container itself.
+  particles.resize(particles.capacity());
+  particles.emplace_back(particles[0].get<0>(), 2.0F, 1, particles[0].get<3>());
+  assert(particles[particles.size() - 1U].get<3>() == "particle 0");
+  const auto copy = particles;
+  assert(copy.size() == particles.size() && copy[5].get<3>() == "particle 5");
+  particles.resize(10U);
+  particles.pop_back();
+  assert(particles.size() == 9U && copy.size() > 1000U);
+
+  // Instrumented calls record their latency per call site. Without
+  // -DCPP_TEMPLATES_INSTRUMENTATION=1, they are plain invocations.
+  struct SquareSite {};
+  using SquareLatency = LatencyHistogram<SquareSite, CycleClock>;
+  for (auto i = 0; i < 100; ++i)
+    assert(call<SquareLatency>([](int j) { return j * j; }, i) == i * i);
+  call<SquareLatency>(f, 7);
+  const auto latencies = SquareLatency::snapshot();
+  assert(latencies.count == (InstrumentationEnabled ? 101U : 0U));
+  std::cout << "Median latency is below " << latencies.quantile(0.5)
+            << " cycles" << '\n';
+
   return 0;
 }
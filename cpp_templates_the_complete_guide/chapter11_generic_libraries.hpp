@@ -1,47 +1,756 @@
 #ifndef CPP_TEMPLATES_CHAPTER11_GENERIC_LIBRARIES
 #define CPP_TEMPLATES_CHAPTER11_GENERIC_LIBRARIES
 
+#include "chapter20_overloading_on_type_properties.hpp"
+#include "chapter24_typelists.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Contiguous iterators other than pointers are replaced by pointers, which
+// spares the optimizer from seeing through the iterator abstraction.
+template <typename Iter>
+constexpr bool LoopsOverPointers =
+    IsContiguousIteratorT<Iter>::value && !std::is_pointer_v<Iter>;
+
 template <typename Iter, typename Callable>
 void foreach (Iter current, Iter end, Callable op) {
-  while (current != end) {
-    op(*current);
-    ++current;
+  if constexpr (LoopsOverPointers<Iter>) {
+    if (current != end) {
+      auto *first = std::addressof(*current);
+      foreach (first, first + (end - current), op)
+        ;
+    }
+  } else {
+    while (current != end) {
+      op(*current);
+      ++current;
+    }
   }
 }
 
 // Generalizes previous foreach...
 template <typename Iter, typename Callable, typename... Args>
 void foreach (Iter current, Iter end, Callable op, const Args &...args) {
-  while (current != end) {
-    // If op is a member function, the first arg is the this object.
-    // Do not perfect-forward args as we may invoke multiple times.
-    std::invoke(op, args..., *current);
-    ++current;
+  if constexpr (LoopsOverPointers<Iter>) {
+    if (current != end) {
+      auto *first = std::addressof(*current);
+      foreach (first, first + (end - current), op, args...)
+        ;
+    }
+  } else {
+    while (current != end) {
+      // If op is a member function, the first arg is the this object.
+      // Do not perfect-forward args as we may invoke multiple times.
+      std::invoke(op, args..., *current);
+      ++current;
+    }
+  }
+}
+
+// Parallel foreach
+
+// Thread pool where every worker owns a queue of jobs. Workers take jobs from
+// the back of their own queue and steal from the front of the queues of other
+// workers once their own queue runs dry. This keeps all threads busy even if
+// the jobs take different amounts of time.
+class WorkStealingPool {
+public:
+  using Job = std::function<void()>;
+
+  // A pool without workers could not run jobs, so it gets at least one.
+  explicit WorkStealingPool(std::size_t thread_count = default_thread_count())
+      : queues(std::make_unique<Queue[]>(std::max<std::size_t>(thread_count,
+                                                               1U))),
+        queue_count{std::max<std::size_t>(thread_count, 1U)} {
+    workers.reserve(queue_count);
+    for (std::size_t index = 0U; index < queue_count; ++index)
+      workers.emplace_back([this, index] { work(index); });
+  }
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+  ~WorkStealingPool() {
+    {
+      const auto lock = std::lock_guard{sleep_mutex};
+      stop = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers)
+      worker.join();
+  }
+
+  // hardware_concurrency() may return zero if it cannot be determined.
+  static std::size_t default_thread_count() noexcept {
+    return std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  std::size_t size() const noexcept { return workers.size(); }
+
+  // Pushes to the queue of the calling worker so the job stays on its thread,
+  // or distributes jobs round-robin when called from outside the pool.
+  void submit(Job job) {
+    const auto index = current_pool == this
+                           ? current_index
+                           : next_queue.fetch_add(1U) % queue_count;
+    {
+      const auto lock = std::lock_guard{queues[index].mutex};
+      queues[index].jobs.push_back(std::move(job));
+    }
+    {
+      const auto lock = std::lock_guard{sleep_mutex};
+      ++queued;
+    }
+    wake.notify_one();
+  }
+
+  // Runs a pending job on the calling thread. Returns false if there was none.
+  bool run_one() {
+    auto job = Job{};
+    if (!pop(current_pool == this ? current_index : 0U, job))
+      return false;
+    job();
+    return true;
+  }
+
+  // Calls task(chunk) for all chunks in [0, chunk_count) and blocks until all
+  // of them have finished. The calling thread helps out instead of idling.
+  // The first exception thrown by a task is rethrown to the caller.
+  template <typename Task>
+  void parallel_for(std::size_t chunk_count, const Task &task) {
+    auto remaining = std::atomic<std::size_t>{chunk_count};
+    auto error = std::exception_ptr{};
+    auto error_mutex = std::mutex{};
+    for (std::size_t chunk = 0U; chunk < chunk_count; ++chunk) {
+      submit([&, chunk] {
+        try {
+          task(chunk);
+        } catch (...) {
+          const auto lock = std::lock_guard{error_mutex};
+          if (!error)
+            error = std::current_exception();
+        }
+        remaining.fetch_sub(1U, std::memory_order_release);
+      });
+    }
+    while (remaining.load(std::memory_order_acquire) != 0U) {
+      if (!run_one())
+        std::this_thread::yield();
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+private:
+  // Padded to avoid false sharing between the queues of different workers.
+  struct alignas(CacheLineSize) Queue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  bool pop(std::size_t index, Job &job) {
+    {
+      auto &own = queues[index];
+      const auto lock = std::lock_guard{own.mutex};
+      if (!own.jobs.empty()) {
+        job = std::move(own.jobs.back());
+        own.jobs.pop_back();
+        return take_queued();
+      }
+    }
+    for (std::size_t offset = 1U; offset < queue_count; ++offset) {
+      auto &victim = queues[(index + offset) % queue_count];
+      const auto lock = std::lock_guard{victim.mutex};
+      if (!victim.jobs.empty()) {
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        return take_queued();
+      }
+    }
+    return false;
+  }
+
+  bool take_queued() {
+    const auto lock = std::lock_guard{sleep_mutex};
+    --queued;
+    return true;
+  }
+
+  void work(std::size_t index) {
+    current_pool = this;
+    current_index = index;
+    auto job = Job{};
+    while (true) {
+      if (pop(index, job)) {
+        job();
+        job = nullptr;
+        continue;
+      }
+      auto lock = std::unique_lock{sleep_mutex};
+      wake.wait(lock, [this] { return stop || queued != 0U; });
+      if (stop && queued == 0U)
+        return;
+    }
+  }
+
+  inline static thread_local const WorkStealingPool *current_pool{nullptr};
+  inline static thread_local std::size_t current_index{0U};
+
+  std::unique_ptr<Queue[]> queues;
+  std::size_t queue_count;
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> next_queue{0U};
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  std::size_t queued{0U};
+  bool stop{false};
+};
+
+// Non-owning view of a contiguous sequence of elements that is handed to the
+// callable of foreach_batched.
+template <typename T> class Span {
+public:
+  constexpr Span(T *first, std::size_t size) noexcept
+      : first{first}, count{size} {}
+  constexpr T *data() const noexcept { return first; }
+  constexpr std::size_t size() const noexcept { return count; }
+  constexpr T *begin() const noexcept { return first; }
+  constexpr T *end() const noexcept { return first + count; }
+  constexpr T &operator[](std::size_t index) const noexcept {
+    return first[index];
+  }
+
+private:
+  T *first;
+  std::size_t count;
+};
+
+// Every worker gets a few chunks so that stealing can even out imbalances.
+inline constexpr std::size_t ChunksPerWorker = 4U;
+
+// Splits [current, end) into chunks and calls chunk_op(first, size) for each of
+// them on the pool.
+template <typename Iter, typename ChunkOp>
+void foreach_chunk(WorkStealingPool &pool, Iter current, Iter end,
+                   const ChunkOp &chunk_op) {
+  const auto size = static_cast<std::size_t>(end - current);
+  if (size == 0U)
+    return;
+  const auto chunk_count = std::min(size, pool.size() * ChunksPerWorker);
+  const auto chunk_size = (size + chunk_count - 1U) / chunk_count;
+  pool.parallel_for((size + chunk_size - 1U) / chunk_size,
+                    [&](std::size_t chunk) {
+                      const auto offset = chunk * chunk_size;
+                      chunk_op(current + offset,
+                               std::min(chunk_size, size - offset));
+                    });
+}
+
+// Like advance_dispatch in chapter 20: Only random access ranges can be split
+// cheaply, so all other ranges use the sequential foreach.
+template <typename Iter, typename Callable, typename... Args>
+void foreach_dispatch_impl(WorkStealingPool &, Iter current, Iter end,
+                           std::input_iterator_tag, const Callable &op,
+                           const Args &...args) {
+  foreach (current, end, op, args...)
+    ;
+}
+template <typename Iter, typename Callable, typename... Args>
+void foreach_dispatch_impl(WorkStealingPool &pool, Iter current, Iter end,
+                           std::random_access_iterator_tag, const Callable &op,
+                           const Args &...args) {
+  foreach_chunk(pool, current, end, [&](Iter first, std::size_t size) {
+    for (const auto last = first + size; first != last; ++first)
+      std::invoke(op, args..., *first);
+  });
+}
+
+// Parallel foreach. Supports the same callables and extra arguments as the
+// sequential foreach. The callable is invoked concurrently from multiple
+// threads and must therefore be safe to do so.
+template <typename Iter, typename Callable, typename... Args>
+void foreach (WorkStealingPool &pool, Iter current, Iter end, Callable op,
+              const Args &...args) {
+  foreach_dispatch_impl(
+      pool, current, end,
+      typename std::iterator_traits<Iter>::iterator_category(), op, args...);
+}
+
+// Batched parallel foreach. Instead of invoking op for every element, op is
+// invoked with a Span over a contiguous chunk of elements. Its inner loop over
+// the span is then visible to the compiler and can be vectorized.
+template <typename Iter, typename Callable, typename... Args>
+void foreach_batched(WorkStealingPool &pool, Iter current, Iter end,
+                     Callable op, const Args &...args) {
+  static_assert(IsContiguousIteratorT<Iter>::value,
+                "Batches require a contiguous range");
+  using Element = std::remove_reference_t<decltype(*current)>;
+  foreach_chunk(pool, current, end, [&](Iter first, std::size_t size) {
+    std::invoke(op, args..., Span<Element>{&*first, size});
+  });
+}
+
+// Structure of arrays
+
+// A std::vector of structs (array of structures) interleaves all fields of a
+// row in memory. Loops that only touch a few of the fields still load whole
+// cache lines full of the other fields. SoAVector stores every field in a
+// column of its own instead, so such loops only load the columns they use and
+// their inner loops over a column can be vectorized, e.g. by accum or a
+// batched foreach over a column span.
+//
+// All columns live in a single allocation. Every column starts at a cache line
+// boundary (or the alignment of its field if that is larger), which keeps the
+// columns apart and suits aligned SIMD loads. Growing reallocates all columns
+// at once. Rows are accessed through proxies that refer to the fields of the
+// row in their columns.
+template <typename List> class SoAVector;
+
+// Proxy for a row of a SoAVector. SoARow<Fields...> refers to a mutable row and
+// SoARow<const Fields...> to an immutable one. Supports structured bindings,
+// which bind references to the fields.
+template <typename... Fields> class SoARow {
+public:
+  template <std::size_t I> auto &get() const noexcept {
+    return std::get<I>(fields)[index];
+  }
+
+private:
+  template <typename List> friend class SoAVector;
+  SoARow(std::tuple<Fields *...> fields, std::size_t index) noexcept
+      : fields{fields}, index{index} {}
+
+  std::tuple<Fields *...> fields;
+  std::size_t index;
+};
+
+namespace std {
+template <typename... Fields>
+struct tuple_size<SoARow<Fields...>>
+    : integral_constant<size_t, sizeof...(Fields)> {};
+template <size_t I, typename... Fields>
+struct tuple_element<I, SoARow<Fields...>> {
+  using type = flat::NthElement<Typelist<Fields...>, I> &;
+};
+} // namespace std
+
+template <typename... Fields> class SoAVector<Typelist<Fields...>> {
+public:
+  static_assert(sizeof...(Fields) > 0U, "SoAVector needs at least one field");
+  static_assert((std::is_nothrow_move_constructible_v<Fields> && ...),
+                "Growing moves the fields and must not throw");
+
+  using FieldList = Typelist<Fields...>;
+  template <std::size_t I> using Field = flat::NthElement<FieldList, I>;
+  using Reference = SoARow<Fields...>;
+  using ConstReference = SoARow<const Fields...>;
+
+  static constexpr std::size_t ColumnAlignment =
+      std::max({CacheLineSize, alignof(Fields)...});
+
+  SoAVector() = default;
+  explicit SoAVector(std::size_t size) { resize(size); }
+
+  SoAVector(const SoAVector &other) {
+    reserve(other.count);
+    try {
+      copy_columns(other, Indices{});
+    } catch (...) {
+      deallocate(arena);
+      throw;
+    }
+    count = other.count;
+  }
+  SoAVector(SoAVector &&other) noexcept
+      : arena{std::exchange(other.arena, nullptr)},
+        columns{std::exchange(other.columns, {})},
+        count{std::exchange(other.count, 0U)},
+        reserved{std::exchange(other.reserved, 0U)} {}
+
+  SoAVector &operator=(SoAVector other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~SoAVector() {
+    clear();
+    deallocate(arena);
   }
+
+  void swap(SoAVector &other) noexcept {
+    std::swap(arena, other.arena);
+    std::swap(columns, other.columns);
+    std::swap(count, other.count);
+    std::swap(reserved, other.reserved);
+  }
+
+  std::size_t size() const noexcept { return count; }
+  std::size_t capacity() const noexcept { return reserved; }
+  bool empty() const noexcept { return count == 0U; }
+
+  void reserve(std::size_t capacity) {
+    if (capacity > reserved)
+      reallocate(capacity, [](const std::tuple<Fields *...> &) {});
+  }
+
+  // Appends a row, the fields are given in the order of the typelist. The
+  // arguments may refer to fields of this SoAVector: when growing, the new row
+  // is constructed before the old rows are moved.
+  template <typename... Args> void emplace_back(Args &&...args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields),
+                  "emplace_back takes one argument per field");
+    if (count == reserved) {
+      reallocate(std::max<std::size_t>(2U * reserved, MinCapacity),
+                 [&](const std::tuple<Fields *...> &to) {
+                   construct_row(to, Indices{}, std::forward<Args>(args)...);
+                 });
+    } else {
+      construct_row(columns, Indices{}, std::forward<Args>(args)...);
+    }
+    ++count;
+  }
+  void push_back(const Fields &...fields) { emplace_back(fields...); }
+
+  void pop_back() noexcept {
+    --count;
+    destroy_rows(count, count + 1U, Indices{});
+  }
+
+  // Appends value-initialized rows or removes rows from the back.
+  void resize(std::size_t size) {
+    if (size < count) {
+      destroy_rows(size, count, Indices{});
+      count = size;
+      return;
+    }
+    reserve(size);
+    for (; count < size; ++count)
+      construct_row(columns, Indices{}, Fields()...);
+  }
+
+  void clear() noexcept {
+    destroy_rows(0U, count, Indices{});
+    count = 0U;
+  }
+
+  Reference operator[](std::size_t index) noexcept {
+    return Reference{columns, index};
+  }
+  ConstReference operator[](std::size_t index) const noexcept {
+    return ConstReference{std::apply(
+                              [](auto *...column) {
+                                return std::tuple<const Fields *...>{column...};
+                              },
+                              columns),
+                          index};
+  }
+
+  // Contiguous view of a single column.
+  template <std::size_t I> Span<Field<I>> column() noexcept {
+    return Span<Field<I>>{std::get<I>(columns), count};
+  }
+  template <std::size_t I> Span<const Field<I>> column() const noexcept {
+    return Span<const Field<I>>{std::get<I>(columns), count};
+  }
+
+private:
+  using Indices = std::index_sequence_for<Fields...>;
+  static constexpr std::size_t MinCapacity = 16U;
+
+  static constexpr std::size_t align_up(std::size_t bytes) noexcept {
+    return (bytes + ColumnAlignment - 1U) / ColumnAlignment * ColumnAlignment;
+  }
+
+  static void deallocate(void *arena) noexcept {
+    if (arena != nullptr)
+      ::operator delete(arena, std::align_val_t{ColumnAlignment});
+  }
+
+  // Allocates one arena for all columns, calls construct(new_columns) and
+  // moves the rows over.
+  template <typename Construct>
+  void reallocate(std::size_t capacity, const Construct &construct) {
+    auto *new_arena =
+        static_cast<unsigned char *>(::operator new(
+            (align_up(sizeof(Fields) * capacity) + ...),
+            std::align_val_t{ColumnAlignment}));
+    auto offset = std::size_t{0U};
+    const auto carve = [&](std::size_t field_size) {
+      auto *column = new_arena + offset;
+      offset += align_up(field_size * capacity);
+      return column;
+    };
+    // Braced initialization evaluates the columns from left to right.
+    const auto new_columns = std::tuple<Fields *...>{
+        reinterpret_cast<Fields *>(carve(sizeof(Fields)))...};
+    try {
+      construct(new_columns);
+    } catch (...) {
+      deallocate(new_arena);
+      throw;
+    }
+    relocate_columns(new_columns, Indices{});
+    deallocate(arena);
+    arena = new_arena;
+    columns = new_columns;
+    reserved = capacity;
+  }
+
+  // Columns of trivially relocatable fields are moved by a single memmove.
+  template <std::size_t... Is>
+  void relocate_columns(const std::tuple<Fields *...> &to,
+                        std::index_sequence<Is...>) noexcept {
+    (relocate_n(std::get<Is>(columns), count, std::get<Is>(to)), ...);
+  }
+
+  // Columns that are already copied are destroyed again if a copy throws.
+  template <std::size_t... Is>
+  void copy_columns(const SoAVector &other, std::index_sequence<Is...>) {
+    auto copied = std::size_t{0U};
+    try {
+      ((std::uninitialized_copy_n(std::get<Is>(other.columns), other.count,
+                                  std::get<Is>(columns)),
+        ++copied),
+       ...);
+    } catch (...) {
+      ((Is < copied ? (void)std::destroy_n(std::get<Is>(columns), other.count)
+                    : void()),
+       ...);
+      throw;
+    }
+  }
+
+  // Constructs the fields of row count in to. Fields that are already
+  // constructed are destroyed again if constructing a later field throws.
+  template <std::size_t... Is, typename... Args>
+  void construct_row(const std::tuple<Fields *...> &to,
+                     std::index_sequence<Is...>, Args &&...args) {
+    auto constructed = std::size_t{0U};
+    try {
+      ((::new (static_cast<void *>(std::get<Is>(to) + count))
+            Fields(std::forward<Args>(args)),
+        ++constructed),
+       ...);
+    } catch (...) {
+      ((Is < constructed ? std::destroy_at(std::get<Is>(to) + count) : void()),
+       ...);
+      throw;
+    }
+  }
+
+  template <std::size_t... Is>
+  void destroy_rows(std::size_t first, std::size_t last,
+                    std::index_sequence<Is...>) noexcept {
+    (std::destroy(std::get<Is>(columns) + first, std::get<Is>(columns) + last),
+     ...);
+  }
+
+  void *arena{nullptr};
+  std::tuple<Fields *...> columns{};
+  std::size_t count{0U};
+  std::size_t reserved{0U};
+};
+
+// Instrumentation
+
+// Compile with -DCPP_TEMPLATES_INSTRUMENTATION=1 to enable the instrumentation
+// of call() below. Otherwise, every instrumentation policy is disabled and
+// call() compiles down to the bare std::invoke.
+#ifndef CPP_TEMPLATES_INSTRUMENTATION
+#define CPP_TEMPLATES_INSTRUMENTATION 0
+#endif
+inline constexpr bool InstrumentationEnabled =
+    CPP_TEMPLATES_INSTRUMENTATION != 0;
+
+// Clocks measure latencies in ticks of their own.
+// Nanoseconds of a monotonic wall clock.
+struct WallClock {
+  static std::uint64_t now() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+};
+// Cycles of the CPU timestamp counter. Much cheaper to read than the wall clock
+// but the tick rate depends on the CPU. Falls back to the wall clock on
+// platforms without a known counter.
+struct CycleClock {
+  static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return WallClock::now();
+#endif
+  }
+};
+
+// Latency histogram with one bucket per power of two: bucket i counts
+// latencies with a bit width of i, i.e. in [2^(i-1), 2^i).
+inline constexpr std::size_t LatencyBucketCount = 65U;
+
+inline std::size_t latency_bucket(std::uint64_t ticks) noexcept {
+#if defined(__GNUC__)
+  return ticks == 0U ? 0U
+                     : 64U - static_cast<std::size_t>(__builtin_clzll(ticks));
+#else
+  auto width = std::size_t{0U};
+  for (; ticks != 0U; ticks >>= 1U)
+    ++width;
+  return width;
+#endif
 }
 
+// Aggregated view of the histograms of all threads.
+struct LatencySnapshot {
+  std::array<std::uint64_t, LatencyBucketCount> buckets{};
+  std::uint64_t count{0U};
+  std::uint64_t total{0U};
+
+  double mean() const noexcept {
+    return count == 0U ? 0.0
+                       : static_cast<double>(total) /
+                             static_cast<double>(count);
+  }
+  // Returns the upper bound of the bucket that contains quantile q in [0, 1].
+  std::uint64_t quantile(double q) const noexcept {
+    const auto rank =
+        static_cast<std::uint64_t>(q * static_cast<double>(count));
+    auto seen = std::uint64_t{0U};
+    for (std::size_t bucket = 0U; bucket < LatencyBucketCount; ++bucket) {
+      seen += buckets[bucket];
+      if (seen > rank || seen == count)
+        return bucket == 0U ? 0U : ~std::uint64_t{0U} >> (64U - bucket);
+    }
+    return 0U;
+  }
+};
+
+// Histogram owned by a single thread. Only the owning thread writes to it, so
+// recording needs no read-modify-write atomics: a relaxed load and store are
+// enough for other threads to read consistent (if slightly stale) counts.
+struct ThreadLatencyHistogram {
+  std::array<std::atomic<std::uint64_t>, LatencyBucketCount> buckets{};
+  std::atomic<std::uint64_t> count{0U};
+  std::atomic<std::uint64_t> total{0U};
+
+  static void increment(std::atomic<std::uint64_t> &counter,
+                        std::uint64_t value) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+  }
+  void record(std::uint64_t ticks) noexcept {
+    increment(buckets[latency_bucket(ticks)], 1U);
+    increment(count, 1U);
+    increment(total, ticks);
+  }
+};
+
+// Instrumentation policies implement start(), which returns a token, and
+// stop(token), which is called once the wrapped call returned.
+
+// Does nothing. call() does not even evaluate start() and stop().
+struct NoInstrumentation {
+  static constexpr bool enabled = false;
+};
+using DefaultInstrumentation = NoInstrumentation;
+
+// Records the latency of all calls to call<LatencyHistogram<Site>>(...) for
+// the call site identified by the tag type Site into per-thread histograms.
+// The histograms are registered once per thread and never freed, so
+// snapshot() still sees the latencies recorded by threads that have exited.
+template <typename Site, typename Clock = WallClock> class LatencyHistogram {
+public:
+  static constexpr bool enabled = InstrumentationEnabled;
+
+  static std::uint64_t start() noexcept { return Clock::now(); }
+  static void stop(std::uint64_t start) noexcept {
+    local().record(Clock::now() - start);
+  }
+
+  static LatencySnapshot snapshot() {
+    auto result = LatencySnapshot{};
+    auto &r = registry();
+    const auto lock = std::lock_guard{r.mutex};
+    for (const auto &histogram : r.histograms) {
+      for (std::size_t bucket = 0U; bucket < LatencyBucketCount; ++bucket)
+        result.buckets[bucket] +=
+            histogram->buckets[bucket].load(std::memory_order_relaxed);
+      result.count += histogram->count.load(std::memory_order_relaxed);
+      result.total += histogram->total.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+private:
+  struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadLatencyHistogram>> histograms;
+  };
+  static Registry &registry() {
+    static auto r = Registry{};
+    return r;
+  }
+  static ThreadLatencyHistogram &local() noexcept {
+    // Registration takes a lock, but only once per thread.
+    thread_local auto *histogram = [] {
+      auto &r = registry();
+      const auto lock = std::lock_guard{r.mutex};
+      return r.histograms
+          .emplace_back(std::make_unique<ThreadLatencyHistogram>())
+          .get();
+    }();
+    return *histogram;
+  }
+};
+
 // Wrap a single function call and do some additional work (logging, measuring).
-template <typename Callable, typename... Args>
+// The Instrumentation policy defines the additional work and defaults to none.
+// It comes first so it can be given explicitly while the remaining template
+// arguments are still deduced: call<LatencyHistogram<struct Parse>>(parse, s).
+template <typename Instrumentation = DefaultInstrumentation, typename Callable,
+          typename... Args>
 // We use decltype(auto) as we want to return the exact return type.
 decltype(auto) call(Callable &&op, Args &&...args) {
-  // Initializing decltype(auto) ret as void is not allowed. We need to
-  // distinguish between function calls that return void and non-void.
-  if constexpr (std::is_same_v<std::invoke_result_t<Callable, Args...>, void>) {
+  if constexpr (!Instrumentation::enabled) {
+    // Nothing to do, so do not even introduce a local variable.
+    return std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
+  } else if constexpr (std::is_same_v<std::invoke_result_t<Callable, Args...>,
+                                      void>) {
+    // Initializing decltype(auto) ret as void is not allowed. We need to
+    // distinguish between function calls that return void and non-void.
+    const auto token = Instrumentation::start();
     std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
-    // Do something...
+    Instrumentation::stop(token);
     return;
   } else {
+    const auto token = Instrumentation::start();
     decltype(auto) ret =
         std::invoke(std::forward<Callable>(op), std::forward<Args>(args)...);
-    // Do something...
+    Instrumentation::stop(token);
     return ret;
   }
 }
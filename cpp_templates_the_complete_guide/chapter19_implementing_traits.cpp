@@ -1,3 +1,41 @@
 #include "chapter19_implementing_traits.hpp"
+#include <cassert>
+#include <string>
+#include <vector>
 
-int main() { return 0; }
+int main() {
+  const auto values = std::vector<int>(1000U, 3);
+  // Integral sums take the vectorized path as their traits allow reassociation.
+  const auto total = accum<std::vector<int>::const_iterator, SumPolicy>(
+      values.begin(), values.end());
+  assert(total == 3000);
+
+  // Floating-point sums keep the scalar order unless the traits permit
+  // reassociation.
+  const auto samples = std::vector<float>(1000U, 0.25F);
+  const auto *first = samples.data();
+  const auto *last = first + samples.size();
+  const auto exact = accum<const float *, SumPolicy>(first, last);
+  const auto fast =
+      accum<const float *, SumPolicy, ReassociatingAccumulationTraits<float>>(
+          first, last);
+  assert(exact == 250.0 && fast == 250.0);
+
+  // Checking for an operation and its result share a single probe.
+  static_assert(HasPlusT<int, double>::value && !HasPlusT<int, void *>::value);
+  static_assert(std::is_same_v<PlusResult<int, double>, double>);
+  static_assert(
+      std::is_same_v<DetectedT<PlusOp, std::string, int *>, Nonesuch>);
+  static_assert(std::is_same_v<decltype(Array<int>{} + Array<double>{}),
+                               Array<double>>);
+  static_assert(IsDefaultConstructibleT3<int>::value &&
+                !IsDefaultConstructibleT3<int &>::value);
+  static_assert(HasSizeTypeT<const std::vector<int>>::value &&
+                !HasSizeTypeT<int>::value);
+  static_assert(IsIterableT<std::string>::value && !IsIterableT<int>::value);
+#if defined(__cpp_concepts)
+  static_assert(HasPlus<std::string, const char *> && !HasPlus<int, void *>);
+#endif
+
+  return 0;
+}
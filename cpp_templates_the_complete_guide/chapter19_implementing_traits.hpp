@@ -1,10 +1,19 @@
 #ifndef CPP_TEMPLATES_CHAPTER19_IMPLEMENTING_TRAITS
 #define CPP_TEMPLATES_CHAPTER19_IMPLEMENTING_TRAITS
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <tuple>
 #include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 // Helper to ignore any number of template parameters.
 #ifndef __cpp_lib_void_t
@@ -31,15 +40,48 @@ template <typename...> using void_t = void;
 
 template <typename T> struct AccumulationTraits {};
 
+// The reassociate member opts the type into the vectorized accumulation below.
+// It states whether the additions may be performed in any order. This holds for
+// integral sums which are exact (or wrap around) regardless of the order.
 template <> struct AccumulationTraits<char> {
   using AccT = unsigned int;
   // Or use static member-function for non-primitive types
   static constexpr AccT zero = 0;
+  static constexpr bool reassociate = true;
+};
+
+template <> struct AccumulationTraits<int> {
+  // Accumulate into a wider type to postpone overflow.
+  using AccT = long long;
+  static constexpr AccT zero = 0;
+  static constexpr bool reassociate = true;
 };
 
 template <> struct AccumulationTraits<long> {
   using AccT = long;
   static constexpr AccT zero = 0;
+  static constexpr bool reassociate = true;
+};
+
+// Floating-point addition is not associative, so reordering the sum changes
+// its rounding. The default traits therefore keep the exact scalar order.
+template <> struct AccumulationTraits<float> {
+  using AccT = double;
+  static constexpr AccT zero = 0.0;
+  static constexpr bool reassociate = false;
+};
+
+template <> struct AccumulationTraits<double> {
+  using AccT = double;
+  static constexpr AccT zero = 0.0;
+  static constexpr bool reassociate = false;
+};
+
+// Custom traits that trade the exact order of a sum for speed.
+// accum<const float *, SumPolicy, ReassociatingAccumulationTraits<float>>(...)
+template <typename T>
+struct ReassociatingAccumulationTraits : AccumulationTraits<T> {
+  static constexpr bool reassociate = true;
 };
 
 // Policy that defines what accumulation means in this context.
@@ -48,7 +90,270 @@ struct SumPolicy {
   static void accumulate(T1 &total, const T2 &value) {
     total += value;
   }
+  // Merges two partial results, e.g. of a parallel accumulation. For sums,
+  // this is just another accumulation.
+  template <typename T> static void combine(T &total, const T &partial) {
+    accumulate(total, partial);
+  }
+};
+
+// Vectorized accumulation
+
+// A scalar loop like the one in accum() below cannot run faster than the
+// latency of one addition per element because every addition depends on the
+// result of the previous one (a loop-carried dependency). Splitting the sum
+// into several independent partial sums breaks this dependency and allows the
+// CPU to overlap the additions. Each partial sum can itself be a SIMD register
+// that adds multiple elements at once.
+// This reorders the additions, so it is only done when the traits declare that
+// reassociation is allowed and the policy is known to be a plain sum.
+
+// Detects traits that permit reassociation. Defaults to false if the traits do
+// not provide the reassociate member.
+template <typename Traits, typename = std::void_t<>>
+struct AllowsReassociationT : std::false_type {};
+template <typename Traits>
+struct AllowsReassociationT<Traits, std::void_t<decltype(Traits::reassociate)>>
+    : std::bool_constant<Traits::reassociate> {};
+
+// Detects iterators over contiguous memory that can be replaced by pointers.
+template <typename Iter, typename = void>
+struct IsContiguousIteratorT : std::false_type {};
+template <typename T> struct IsContiguousIteratorT<T *> : std::true_type {};
+// Iterators of std::vector<T> other than the proxy iterators of
+// std::vector<bool>. We cannot deduce T from the nested iterator type, so we
+// take the value type from the iterator itself and compare.
+template <typename Iter, typename T = typename std::iterator_traits<
+                              Iter>::value_type>
+constexpr bool IsVectorIterator =
+    !std::is_same_v<T, bool> &&
+    (std::is_same_v<Iter, typename std::vector<T>::iterator> ||
+     std::is_same_v<Iter, typename std::vector<T>::const_iterator>);
+// Iterators that declare themselves contiguous, e.g. the ones derived from
+// ContiguousIteratorFacade in chapter 21.
+template <typename Iter, typename = void>
+struct DeclaresContiguousT : std::false_type {};
+template <typename Iter>
+struct DeclaresContiguousT<
+    Iter, std::void_t<decltype(Iter::is_contiguous_iterator)>>
+    : std::bool_constant<Iter::is_contiguous_iterator> {};
+template <typename Iter>
+struct IsContiguousIteratorT<
+    Iter, std::enable_if_t<!std::is_pointer_v<Iter> &&
+                           (IsVectorIterator<Iter> ||
+                            DeclaresContiguousT<Iter>::value)>>
+    : std::true_type {};
+
+// Number of independent partial sums.
+inline constexpr std::size_t AccumulatorCount = 4U;
+
+// Portable kernel. Compilers are able to auto-vectorize the inner loop.
+template <typename AccT, typename T>
+AccT accum_unrolled(const T *first, const T *last, AccT total) {
+  AccT partial[AccumulatorCount]{};
+  for (; static_cast<std::size_t>(last - first) >= AccumulatorCount;
+       first += AccumulatorCount) {
+    for (std::size_t k = 0U; k < AccumulatorCount; ++k)
+      partial[k] += first[k];
+  }
+  for (std::size_t k = 0U; k < AccumulatorCount; ++k)
+    total += partial[k];
+  for (; first != last; ++first)
+    total += *first;
+  return total;
+}
+
+// SIMD operations to sum elements of type T into registers of AccT lanes.
+// Specializations provide Reg, the number of elements consumed per load
+// (width), zero(), load() that converts width elements to AccT lanes, add() and
+// store() that writes the lanes to an array of width AccT.
+// The instruction set is picked at compile time from the target flags, e.g.
+// -mavx2 or -march=native.
+template <typename T, typename AccT> struct SimdSumOps {
+  static constexpr bool available = false;
+};
+
+#if defined(__AVX__)
+template <> struct SimdSumOps<float, float> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 8U;
+  using Reg = __m256;
+  static Reg zero() { return _mm256_setzero_ps(); }
+  static Reg load(const float *p) { return _mm256_loadu_ps(p); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static void store(float *p, Reg a) { _mm256_storeu_ps(p, a); }
+};
+template <> struct SimdSumOps<double, double> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 4U;
+  using Reg = __m256d;
+  static Reg zero() { return _mm256_setzero_pd(); }
+  static Reg load(const double *p) { return _mm256_loadu_pd(p); }
+  static Reg add(Reg a, Reg b) { return _mm256_add_pd(a, b); }
+  static void store(double *p, Reg a) { _mm256_storeu_pd(p, a); }
+};
+template <> struct SimdSumOps<float, double> : SimdSumOps<double, double> {
+  static Reg load(const float *p) { return _mm256_cvtps_pd(_mm_loadu_ps(p)); }
+};
+#elif defined(__SSE2__)
+template <> struct SimdSumOps<float, float> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 4U;
+  using Reg = __m128;
+  static Reg zero() { return _mm_setzero_ps(); }
+  static Reg load(const float *p) { return _mm_loadu_ps(p); }
+  static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+  static void store(float *p, Reg a) { _mm_storeu_ps(p, a); }
+};
+template <> struct SimdSumOps<double, double> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 2U;
+  using Reg = __m128d;
+  static Reg zero() { return _mm_setzero_pd(); }
+  static Reg load(const double *p) { return _mm_loadu_pd(p); }
+  static Reg add(Reg a, Reg b) { return _mm_add_pd(a, b); }
+  static void store(double *p, Reg a) { _mm_storeu_pd(p, a); }
+};
+template <> struct SimdSumOps<float, double> : SimdSumOps<double, double> {
+  static Reg load(const float *p) {
+    const auto two_floats =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+    return _mm_cvtps_pd(_mm_castsi128_ps(two_floats));
+  }
+};
+#elif defined(__ARM_NEON)
+template <> struct SimdSumOps<float, float> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 4U;
+  using Reg = float32x4_t;
+  static Reg zero() { return vdupq_n_f32(0.0F); }
+  static Reg load(const float *p) { return vld1q_f32(p); }
+  static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+  static void store(float *p, Reg a) { vst1q_f32(p, a); }
+};
+#if defined(__aarch64__)
+template <> struct SimdSumOps<double, double> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 2U;
+  using Reg = float64x2_t;
+  static Reg zero() { return vdupq_n_f64(0.0); }
+  static Reg load(const double *p) { return vld1q_f64(p); }
+  static Reg add(Reg a, Reg b) { return vaddq_f64(a, b); }
+  static void store(double *p, Reg a) { vst1q_f64(p, a); }
+};
+template <> struct SimdSumOps<float, double> : SimdSumOps<double, double> {
+  static Reg load(const float *p) { return vcvt_f64_f32(vld1_f32(p)); }
 };
+#endif
+#endif
+
+// Widening sums of 32-bit integers into 64-bit lanes.
+#if defined(__AVX2__)
+template <> struct SimdSumOps<std::int32_t, std::int64_t> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 4U;
+  using Reg = __m256i;
+  static Reg zero() { return _mm256_setzero_si256(); }
+  static Reg load(const std::int32_t *p) {
+    return _mm256_cvtepi32_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+  }
+  static Reg add(Reg a, Reg b) { return _mm256_add_epi64(a, b); }
+  static void store(std::int64_t *p, Reg a) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a);
+  }
+};
+#elif defined(__SSE4_1__)
+template <> struct SimdSumOps<std::int32_t, std::int64_t> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 2U;
+  using Reg = __m128i;
+  static Reg zero() { return _mm_setzero_si128(); }
+  static Reg load(const std::int32_t *p) {
+    return _mm_cvtepi32_epi64(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+  }
+  static Reg add(Reg a, Reg b) { return _mm_add_epi64(a, b); }
+  static void store(std::int64_t *p, Reg a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a);
+  }
+};
+#elif defined(__ARM_NEON)
+template <> struct SimdSumOps<std::int32_t, std::int64_t> {
+  static constexpr bool available = true;
+  static constexpr std::size_t width = 2U;
+  using Reg = int64x2_t;
+  static Reg zero() { return vdupq_n_s64(0); }
+  static Reg load(const std::int32_t *p) { return vmovl_s32(vld1_s32(p)); }
+  static Reg add(Reg a, Reg b) { return vaddq_s64(a, b); }
+  static void store(std::int64_t *p, Reg a) { vst1q_s64(p, a); }
+};
+#endif
+
+// Integral types of equal size and signedness share their kernels, e.g. long
+// and long long on LP64 platforms.
+// IfThenElse is only introduced further below, so use its Standard Library
+// counterpart here.
+template <typename T>
+using SimdLane = std::conditional_t<
+    std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4U,
+    std::int32_t,
+    std::conditional_t<std::is_integral_v<T> && std::is_signed_v<T> &&
+                           sizeof(T) == 8U,
+                       std::int64_t, T>>;
+
+// SIMD kernel with AccumulatorCount independent registers of partial sums.
+template <typename Ops, typename AccT, typename T>
+AccT accum_simd(const T *first, const T *last, AccT total) {
+  constexpr auto step = AccumulatorCount * Ops::width;
+  using Lane = SimdLane<AccT>;
+  const auto *lanes = reinterpret_cast<const SimdLane<T> *>(first);
+
+  typename Ops::Reg partial[AccumulatorCount];
+  for (auto &reg : partial)
+    reg = Ops::zero();
+  for (; static_cast<std::size_t>(last - first) >= step;
+       first += step, lanes += step) {
+    for (std::size_t k = 0U; k < AccumulatorCount; ++k)
+      partial[k] = Ops::add(partial[k], Ops::load(lanes + k * Ops::width));
+  }
+  for (std::size_t k = 1U; k < AccumulatorCount; ++k)
+    partial[0U] = Ops::add(partial[0U], partial[k]);
+
+  Lane sums[Ops::width];
+  Ops::store(sums, partial[0U]);
+  for (const auto sum : sums)
+    total += static_cast<AccT>(sum);
+  // Remaining elements that do not fill all registers.
+  return accum_unrolled(first, last, total);
+}
+
+// Sums the contiguous range [first, last) into total in arbitrary order.
+template <typename AccT, typename T>
+AccT accum_contiguous(const T *first, const T *last, AccT total) {
+  using Ops = SimdSumOps<SimdLane<T>, SimdLane<AccT>>;
+  if constexpr (Ops::available)
+    return accum_simd<Ops>(first, last, total);
+  else
+    return accum_unrolled(first, last, total);
+}
+
+// Selects the vectorized path for plain sums over contiguous ranges of
+// arithmetic types whose traits permit reassociation.
+template <typename Iter, typename Traits, bool IsSum>
+constexpr bool UseVectorizedAccum =
+    IsSum && IsContiguousIteratorT<Iter>::value &&
+    std::is_arithmetic_v<typename std::iterator_traits<Iter>::value_type> &&
+    std::is_arithmetic_v<typename Traits::AccT> &&
+    AllowsReassociationT<Traits>::value;
+
+template <typename Iter, typename AccT>
+AccT accum_vectorized(Iter start, Iter end, AccT total) {
+  if (start == end)
+    return total;
+  const auto *first = &*start;
+  return accum_contiguous(first, first + (end - start), total);
+}
 
 // Adding traits as template parameter and providing default value allows the
 // user to substitute in custom traits when needed.
@@ -63,11 +368,16 @@ template <typename Iter, typename Policy = SumPolicy,
               typename std::iterator_traits<Iter>::value_type>>
 auto accum(Iter start, Iter end) {
   auto total = Traits::zero;
-  while (start != end) {
-    Policy::accumulate(total, *start);
-    ++start;
+  if constexpr (UseVectorizedAccum<Iter, Traits,
+                                   std::is_same_v<Policy, SumPolicy>>) {
+    return accum_vectorized(start, end, total);
+  } else {
+    while (start != end) {
+      Policy::accumulate(total, *start);
+      ++start;
+    }
+    return total;
   }
-  return total;
 }
 
 template <typename T1, typename T2> struct SumPolicyTemplate {
@@ -91,11 +401,18 @@ auto accum(Iter start, Iter end) {
   using AccT = typename Traits::AccT;
 
   auto total = Traits::zero;
-  while (start != end) {
-    Policy<AccT, ValueT>::accumulate(total, *start);
-    ++start;
+  if constexpr (UseVectorizedAccum<
+                    Iter, Traits,
+                    std::is_same_v<Policy<AccT, ValueT>,
+                                   SumPolicyTemplate<AccT, ValueT>>>) {
+    return accum_vectorized(start, end, total);
+  } else {
+    while (start != end) {
+      Policy<AccT, ValueT>::accumulate(total, *start);
+      ++start;
+    }
+    return total;
   }
-  return total;
 }
 
 // Removing references
@@ -197,45 +514,113 @@ template <typename T> void foo(T &&t) {
  * }
  */
 
-template <typename, typename, typename = std::void_t<>>
-struct HasPlusT : std::false_type {};
+// Detection idiom
+
+// The traits below all follow the same pattern: a partial specialization whose
+// std::void_t probe is only valid if some expression or type is. The detection
+// idiom (std::experimental::is_detected) factors that pattern out. An
+// operation is an alias template Op<Args...> that names the type of the
+// expression and DetectorT is the only template that probes it. A check for
+// an operation and the computation of its result therefore share a single
+// instantiation of DetectorT, which the compiler memoizes, instead of probing
+// the expression once for each.
+
+// Type that is detected if an operation is not.
+struct Nonesuch {
+  Nonesuch() = delete;
+  ~Nonesuch() = delete;
+  Nonesuch(const Nonesuch &) = delete;
+  void operator=(const Nonesuch &) = delete;
+};
+
+// DetectorT<void, Op, Args...> inherits from true_type and has the Type member
+// Op<Args...> iff that is valid. It inherits from false_type and has no Type
+// member otherwise, so that uses of its Type are SFINAEd-out. The traits below
+// are aliases of it rather than classes that derive from it, which would all
+// have to be instantiated as well.
+#if defined(__cpp_concepts)
+// Compilers cache whether a concept is satisfied and check requirements
+// without instantiating any class template, which makes concepts cheaper than
+// partial specializations.
+template <template <typename...> class Op, typename... Args>
+concept Detected = requires { typename Op<Args...>; };
+
+template <typename, template <typename...> class Op, typename... Args>
+struct DetectorT : std::false_type {};
+template <template <typename...> class Op, typename... Args>
+  requires Detected<Op, Args...>
+struct DetectorT<void, Op, Args...> : std::true_type {
+  using Type = Op<Args...>;
+};
+#else
+template <typename, template <typename...> class Op, typename... Args>
+struct DetectorT : std::false_type {};
+template <template <typename...> class Op, typename... Args>
+struct DetectorT<std::void_t<Op<Args...>>, Op, Args...> : std::true_type {
+  using Type = Op<Args...>;
+};
+#endif
 
+// Inherits from true_type iff Op<Args...> is valid.
+template <template <typename...> class Op, typename... Args>
+using IsDetectedT = DetectorT<void, Op, Args...>;
+template <template <typename...> class Op, typename... Args>
+constexpr bool IsDetected = IsDetectedT<Op, Args...>::value;
+
+// Has the Type member Op<Args...> iff that is valid.
+template <template <typename...> class Op, typename... Args>
+using DetectedResultT = DetectorT<void, Op, Args...>;
+
+// Op<Args...> if valid and Nonesuch otherwise.
+struct NonesuchResultT {
+  using Type = Nonesuch;
+};
+template <template <typename...> class Op, typename... Args>
+using DetectedT =
+    typename std::conditional_t<IsDetected<Op, Args...>,
+                                DetectedResultT<Op, Args...>,
+                                NonesuchResultT>::Type;
+
+// Operation that yields the type of T1 + T2.
 template <typename T1, typename T2>
-struct HasPlusT<T1, T2,
-                std::void_t<decltype(std::declval<T1>() + std::declval<T2>())>>
-    : std::true_type {};
+using PlusOp = decltype(std::declval<T1>() + std::declval<T2>());
+
+template <typename T1, typename T2>
+using HasPlusT = IsDetectedT<PlusOp, T1, T2>;
 
 // Result type traits
-template <typename T1, typename T2, bool = HasPlusT<T1, T2>::value>
-struct PlusResultT {
-  // Declval produces a value of type without requiring type to be
-  // default-constructible.
-  using Type = decltype(std::declval<T1>() + std::declval<T2>());
-};
-// Partial specialization that does not provide the Type member and is the
-// default if there is no operator+() defined for mixing T1 and T2.
-// This leads to functions for which this PlusResultT is invalid, i.e. does
-// not provide the Type member, to be SFINAED-out.
-template <typename T1, typename T2> struct PlusResultT<T1, T2, false> {};
+// Does not provide the Type member if there is no operator+() defined for
+// mixing T1 and T2. This leads to functions for which this PlusResultT is
+// invalid, i.e. does not provide the Type member, to be SFINAED-out.
+// Declval produces a value of type without requiring type to be
+// default-constructible.
+template <typename T1, typename T2>
+using PlusResultT = DetectedResultT<PlusOp, T1, T2>;
 template <typename T1, typename T2>
 using PlusResult = typename PlusResultT<T1, T2>::Type;
 
+#if defined(__cpp_concepts)
+template <typename T1, typename T2>
+concept HasPlus = Detected<PlusOp, T1, T2>;
+#endif
+
 template <typename T> class Array {};
 
 // Nesting of traits to get the decayed type determined by PlusResult.
 // This allows for sensible calls to the plus-operator when types T1 and T2 are
 // different.
-// This would get SFINAED-out if HasPlusT inside PlusResultT evaluates to false
-// and therefore the alias PlusResult is invalid as it lacks the Type member.
+// This would get SFINAED-out if PlusOp is not detected for T1 and T2 and
+// therefore the alias PlusResult is invalid as it lacks the Type member.
 template <typename T1, typename T2>
 Array<RemoveReference<RemoveConstVolatile<PlusResult<T1, T2>>>>
 operator+(const Array<T1> &, const Array<T2> &);
 
-// We do this indirection via HasPlusT because a trait template should never
-// fail at instantiation time if given reasonable template arguments as input.
-// Therefore, it is common to perform the check twice:
+// We do this indirection via DetectedResultT because a trait template should
+// never fail at instantiation time if given reasonable template arguments as
+// input. Without the detection idiom, it is common to perform the check twice:
 // Once to find out whether the operation is valid (HasPlusT)
 // Once to compute the result (PlusResultT)
+// DetectorT does both at once.
 
 // SFNIAE-out function overloads
 
@@ -299,8 +684,16 @@ struct IsDefaultConstructibleT2<T, std::void_t<decltype(T())>>
 // condition (here decltype(T())) needs to be formulated inside the declaration
 // of a template parameter.
 
+// The detection idiom from above turns the condition into an operation of its
+// own and reuses the probe of DetectorT.
+template <typename T> using DefaultConstructOp = decltype(T());
+template <typename T>
+using IsDefaultConstructibleT3 = IsDetectedT<DefaultConstructOp, T>;
+
 // Since C++17, we can specify the condition in a generic lambda to minimize
-// boilerplate code.
+// boilerplate code. Every trait made by is_valid is a closure type of its own
+// and every check resolves is_valid_impl on another lambda, which makes them
+// much more expensive to compile than IsDetectedT.
 
 // Helper checking validity of f(args...) for F f and Args... args.
 template <typename F, typename... Args,
@@ -369,14 +762,10 @@ constexpr auto has_first =
 
 // Detecting members
 
-// Primary template.
-template <typename, typename = std::void_t<>>
-struct HasSizeTypeT : std::false_type {};
-// Partial specialization that might be SFNIAEd-out. Also gets SFNIAEd-out when
-// size_type is private.
-template <typename T>
-struct HasSizeTypeT<T, std::void_t<typename Decay<T>::size_type>>
-    : std::true_type {};
+// Operation that is invalid if there is no size_type member type. Also
+// invalid when size_type is private.
+template <typename T> using SizeTypeOp = typename Decay<T>::size_type;
+template <typename T> using HasSizeTypeT = IsDetectedT<SizeTypeOp, T>;
 
 // Detecting arbitrary properties of a class (like member types, member
 // functions, ...) can be achieved by defining a macro like so.
@@ -389,15 +778,13 @@ struct HasSizeTypeT<T, std::void_t<typename Decay<T>::size_type>>
 // DEFINE_HAS_TYPE(size_type); if (HasTypeT_size_type<int>::value) ...;
 
 // Due to the nature of std::void_t, we can combine multiple constraints into a
-// single trait.
-template <typename, typename = std::void_t<>>
-struct IsIterableT : std::false_type {};
+// single operation.
 template <typename T>
-struct IsIterableT<T, std::void_t<decltype(std::declval<T>().begin()),
-                                  decltype(std::declval<T>().end()),
-                                  decltype(std::declval<T>().cbegin()),
-                                  decltype(std::declval<T>().cend())>>
-    : std::true_type {};
+using IterableOp = std::void_t<decltype(std::declval<T>().begin()),
+                               decltype(std::declval<T>().end()),
+                               decltype(std::declval<T>().cbegin()),
+                               decltype(std::declval<T>().cend())>;
+template <typename T> using IsIterableT = IsDetectedT<IterableOp, T>;
 
 // We can also use generic lambdas to detect arbitrary members since C++17
 // Note that we do not have to take the indirection via value_t as return-type
@@ -480,6 +867,21 @@ struct IsNothrowMoveConstructibleT<T,
                                    std::void_t<decltype(T(std::declval<T>()))>>
     : std::bool_constant<noexcept(T(std::declval<T>()))> {};
 
+// Relocating an object means move-constructing a new object from it and
+// destroying the old one. For many types, this is equivalent to copying their
+// bytes, e.g. for types that own a resource through a pointer and nothing
+// else points back into them (std::unique_ptr, most handles). Their moves are
+// not trivial, so the compiler cannot know this. The trait defaults to
+// trivially copyable types and is meant to be specialized by the user to opt
+// in other types:
+//
+// template <> struct IsTriviallyRelocatableT<Handle> : std::true_type {};
+template <typename T>
+struct IsTriviallyRelocatableT
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+template <typename T>
+constexpr bool IsTriviallyRelocatable = IsTriviallyRelocatableT<T>::value;
+
 // Alias and variable templates reduce boilerpate (no typename and ::type or
 // ::value required) but there are downsides:
 //
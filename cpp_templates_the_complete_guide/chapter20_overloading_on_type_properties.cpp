@@ -1,3 +1,189 @@
 #include "chapter20_overloading_on_type_properties.hpp"
+#include <cassert>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-int main() { return 0; }
+// Owns a resource through a pointer and nothing points back into it, so its
+// bytes can be moved.
+struct Handle {
+  std::unique_ptr<int> resource;
+};
+template <> struct IsTriviallyRelocatableT<Handle> : std::true_type {};
+
+// Moves leave a mark of their own, so the demo can tell them from copies.
+struct ThrowingMove {
+  ThrowingMove() = default;
+  ThrowingMove(const ThrowingMove &) = default;
+  ThrowingMove(ThrowingMove &&) noexcept(false) : value{"moved"} {}
+  std::string value{"copied"};
+};
+
+struct ThrowingMoveOnly {
+  explicit ThrowingMoveOnly(int value) : value{value} {}
+  ThrowingMoveOnly(ThrowingMoveOnly &&other) noexcept(false)
+      : value{std::exchange(other.value, -1)} {}
+  int value;
+};
+
+// Checks a Dictionary against a standard map for random operations.
+template <typename Dict, typename Reference, typename MakeKey>
+void check_against(Dict &dict, Reference &reference, MakeKey make_key) {
+  auto rng = std::mt19937{7U};
+  for (auto i = 0; i < 20000; ++i) {
+    const auto key = make_key(static_cast<int>(rng() % 2000U));
+    switch (rng() % 3U) {
+    case 0U:
+      assert(dict.try_emplace(key, i).second ==
+             reference.try_emplace(key, i).second);
+      break;
+    case 1U:
+      assert(dict.erase(key) == (reference.erase(key) == 1U));
+      break;
+    default:
+      const auto *value = dict.find(key);
+      const auto it = reference.find(key);
+      assert((value == nullptr) == (it == reference.end()));
+      assert(value == nullptr || *value == it->second);
+    }
+  }
+  assert(dict.size() == reference.size());
+  auto visited = std::size_t{0U};
+  dict.for_each([&](const auto &key, int value) {
+    assert(reference.at(key) == value);
+    ++visited;
+  });
+  assert(visited == reference.size());
+}
+
+int main() {
+  auto values = std::vector<int>(1U << 20U);
+  std::iota(values.begin(), values.end(), 0);
+  const auto expected = std::accumulate(values.begin(), values.end(), 0LL);
+
+  // Random access ranges are split into one chunk per thread.
+  const auto total = accum<std::vector<int>::iterator, SumPolicy>(
+      values.begin(), values.end(), 4U);
+  assert(total == expected);
+  // A thread count of 0, as hardware_concurrency() may report, runs serially.
+  assert((accum<std::vector<int>::iterator, SumPolicy>(values.begin(),
+                                                       values.end(), 0U) ==
+          expected));
+
+  // Other ranges are accumulated sequentially.
+  const auto list = std::list<int>(values.begin(), values.end());
+  const auto list_total =
+      accum<std::list<int>::const_iterator, SumPolicy>(list.begin(),
+                                                       list.end(), 4U);
+  assert(list_total == expected);
+
+  // Bulk relocation, copy and fill dispatch on type properties.
+  {
+    static_assert(std::is_same_v<RelocationTag<int>, RelocateByBytesTag>);
+    static_assert(std::is_same_v<RelocationTag<Handle>, RelocateByBytesTag>);
+    static_assert(
+        std::is_same_v<RelocationTag<std::string>, RelocateByMoveTag>);
+    static_assert(
+        std::is_same_v<RelocationTag<ThrowingMove>, RelocateByCopyTag>);
+
+    auto handles = std::allocator<Handle>{}.allocate(3U);
+    auto relocated = std::allocator<Handle>{}.allocate(3U);
+    for (auto i = 0; i < 3; ++i)
+      ::new (handles + i) Handle{std::make_unique<int>(i)};
+    relocate_n(handles, 3U, relocated);
+    assert(*relocated[2].resource == 2);
+    std::destroy_n(relocated, 3U);
+    std::allocator<Handle>{}.deallocate(relocated, 3U);
+    std::allocator<Handle>{}.deallocate(handles, 3U);
+
+    auto strings = std::allocator<ThrowingMove>{}.allocate(2U);
+    auto copies = std::allocator<ThrowingMove>{}.allocate(2U);
+    std::uninitialized_default_construct_n(strings, 2U);
+    relocate_n(strings, 2U, copies);
+    assert(copies[0].value == "copied" && copies[1].value == "copied");
+    std::destroy_n(copies, 2U);
+    std::allocator<ThrowingMove>{}.deallocate(copies, 2U);
+    std::allocator<ThrowingMove>{}.deallocate(strings, 2U);
+
+    // Types that cannot be copied are moved even if that may throw.
+    static_assert(
+        std::is_same_v<RelocationTag<ThrowingMoveOnly>, RelocateByMoveTag>);
+    auto movables = std::allocator<ThrowingMoveOnly>{}.allocate(2U);
+    auto moved = std::allocator<ThrowingMoveOnly>{}.allocate(2U);
+    ::new (movables) ThrowingMoveOnly{1};
+    ::new (movables + 1) ThrowingMoveOnly{2};
+    relocate_n(movables, 2U, moved);
+    assert(moved[0].value == 1 && moved[1].value == 2);
+    std::destroy_n(moved, 2U);
+    std::allocator<ThrowingMoveOnly>{}.deallocate(moved, 2U);
+    std::allocator<ThrowingMoveOnly>{}.deallocate(movables, 2U);
+
+    static_assert(CopiesBytes<const int *, std::vector<int>::iterator>);
+    static_assert(!CopiesBytes<std::list<int>::iterator, int *>);
+    auto ints = std::vector<int>(8U);
+    const int source[] = {1, 2, 3};
+    assert(bulk_copy(source, source + 3, ints.begin() + 1) == ints.begin() + 4);
+    assert(ints[0] == 0 && ints[3] == 3 && ints[4] == 0);
+    bulk_fill(ints.begin(), ints.end(), 0);
+    assert(std::all_of(ints.begin(), ints.end(), [](int i) { return i == 0; }));
+    bulk_fill(ints.begin(), ints.end(), 0x01010101);
+    assert(ints[7] == 0x01010101);
+    bulk_fill(ints.begin(), ints.end(), 7);
+    assert(ints[0] == 7 && ints[7] == 7);
+  }
+
+  // Dictionary picks a Swiss table for hashable keys and a sorted flat map
+  // otherwise (std::pair has no std::hash).
+  {
+    using Point = std::pair<int, int>;
+    static_assert(IsHashableV<std::string> && !IsHashableV<Point>);
+
+    auto swiss = Dictionary<int, int>{};
+    auto unordered = std::unordered_map<int, int>{};
+    check_against(swiss, unordered, [](int i) { return i; });
+
+    auto sorted = Dictionary<Point, int>{};
+    auto ordered = std::map<Point, int>{};
+    check_against(sorted, ordered, [](int i) { return Point{i % 7, i}; });
+    auto previous = Point{-1, -1};
+    sorted.for_each([&previous](const Point &key, int) {
+      assert(previous < key);
+      previous = key;
+    });
+
+    auto copy = swiss;
+    assert(copy.size() == swiss.size());
+    swiss.for_each(
+        [&copy](int key, int value) { assert(*copy.find(key) == value); });
+    const auto moved = std::move(copy);
+    assert(moved.size() == swiss.size() && copy.empty());
+  }
+
+  // Both dictionaries allocate from an arena.
+  {
+    auto arena = Arena{};
+    using StringAllocator = ArenaAllocator<std::pair<std::string, int>>;
+    auto words = Dictionary<std::string, int, StringAllocator>{
+        StringAllocator{arena}};
+    words.reserve(1000U);
+    for (auto i = 0; i < 1000; ++i)
+      words[std::to_string(i)] += i;
+    assert(words.size() == 1000U && *words.find("999") == 999);
+    assert(words.erase("500") && !words.contains("500"));
+
+    using PointAllocator = ArenaAllocator<std::pair<std::pair<int, int>, int>>;
+    auto points = Dictionary<std::pair<int, int>, int, PointAllocator>{
+        PointAllocator{arena}};
+    points[{1, 2}] = 3;
+    assert(*points.find({1, 2}) == 3 && !points.contains({2, 1}));
+  }
+
+  return 0;
+}
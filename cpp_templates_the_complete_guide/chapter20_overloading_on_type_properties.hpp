@@ -1,7 +1,20 @@
 #ifndef CPP_TEMPLATES_CHAPTER20_OVERLOADING_ON_TYPE_PROPERTIES
 #define CPP_TEMPLATES_CHAPTER20_OVERLOADING_ON_TYPE_PROPERTIES
 
+#include "chapter19_implementing_traits.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 // Tag dispatching
 
@@ -40,6 +53,127 @@ void advance_dispatch(Iter &it, Distance n) {
       it, n, typename std::iterator_traits<Iter>::iterator_category());
 }
 
+// Example: Parallel accumulation (see accum in Chapter 19)
+
+// Ranges are split into one chunk per thread. Computing the chunk boundaries is
+// only cheap for random access iterators. For all other iterators, we would
+// need to walk the range sequentially just to split it, so they are not split
+// at all and are accumulated on the calling thread. As with advance_dispatch,
+// the decision is made by overload resolution on the iterator tag.
+
+// Chunks below this size are not worth the cost of starting a thread.
+inline constexpr std::size_t MinAccumChunkSize = 1U << 14U;
+
+// Returns the number of elements per chunk or zero if the range is not split.
+template <typename Iter>
+std::size_t accum_chunk_size_impl(Iter, Iter, std::size_t,
+                                  std::input_iterator_tag) {
+  return 0U;
+}
+template <typename Iter>
+std::size_t accum_chunk_size_impl(Iter start, Iter end,
+                                  std::size_t thread_count,
+                                  std::random_access_iterator_tag) {
+  const auto size = static_cast<std::size_t>(end - start);
+  const auto chunk_size = (size + thread_count - 1U) / thread_count;
+  return chunk_size < MinAccumChunkSize ? MinAccumChunkSize : chunk_size;
+}
+template <typename Iter>
+std::size_t accum_chunk_size(Iter start, Iter end, std::size_t thread_count) {
+  return accum_chunk_size_impl(
+      start, end, thread_count,
+      typename std::iterator_traits<Iter>::iterator_category());
+}
+
+// Uses the combine hook of the policy to merge partial results if it has one
+// and falls back to accumulating the partial result otherwise.
+template <typename Policy, typename AccT, typename = std::void_t<>>
+struct HasCombineT : std::false_type {};
+template <typename Policy, typename AccT>
+struct HasCombineT<Policy, AccT,
+                   std::void_t<decltype(Policy::combine(
+                       std::declval<AccT &>(), std::declval<const AccT &>()))>>
+    : std::true_type {};
+
+template <typename Policy, typename AccT>
+void accum_combine(AccT &total, const AccT &partial) {
+  if constexpr (HasCombineT<Policy, AccT>::value)
+    Policy::combine(total, partial);
+  else
+    Policy::accumulate(total, partial);
+}
+
+// Threads accumulate into adjacent slots of a vector. Padding every slot to a
+// cache line of its own avoids false sharing, i.e. threads invalidating the
+// cache line of their neighbors whenever they write their own slot.
+// std::hardware_destructive_interference_size would be the portable choice but
+// its value may differ between compilers and flags (GCC warns about using it
+// in headers), so we use the common cache line size instead.
+inline constexpr std::size_t CacheLineSize = 64U;
+
+template <typename T> struct alignas(CacheLineSize) CacheLinePadded {
+  T value;
+  std::exception_ptr error{};
+};
+
+// Parallel accum. Splits the range into chunks, accumulates every chunk with
+// the sequential accum on a thread of its own and combines the partial results
+// in chunk order, so the result does not depend on the scheduling of threads.
+// Splitting a floating-point sum changes its order, so that is only done if
+// the traits permit reassociation.
+template <typename Iter, typename Policy = SumPolicy,
+          typename Traits = AccumulationTraits<
+              typename std::iterator_traits<Iter>::value_type>>
+auto accum(Iter start, Iter end, std::size_t thread_count) {
+  using AccT = typename Traits::AccT;
+
+  // std::thread::hardware_concurrency() may return 0, which has to take the
+  // sequential path before it gets to divide the range.
+  if (thread_count <= 1U ||
+      (std::is_floating_point_v<AccT> && !AllowsReassociationT<Traits>::value))
+    return accum<Iter, Policy, Traits>(start, end);
+  const auto chunk_size = accum_chunk_size(start, end, thread_count);
+  if (chunk_size == 0U)
+    return accum<Iter, Policy, Traits>(start, end);
+
+  // Only random access ranges get here, so std::distance is O(1).
+  const auto size = static_cast<std::size_t>(std::distance(start, end));
+  const auto chunk_count = (size + chunk_size - 1U) / chunk_size;
+  if (chunk_count <= 1U)
+    return accum<Iter, Policy, Traits>(start, end);
+
+  auto partials =
+      std::vector<CacheLinePadded<AccT>>(chunk_count, {Traits::zero});
+  const auto accum_chunk = [&](std::size_t chunk) {
+    auto first = start;
+    advance_dispatch(first, chunk * chunk_size);
+    auto last = first;
+    advance_dispatch(last, std::min(chunk_size, size - chunk * chunk_size));
+    try {
+      partials[chunk].value = accum<Iter, Policy, Traits>(first, last);
+    } catch (...) {
+      partials[chunk].error = std::current_exception();
+    }
+  };
+
+  // The calling thread takes the first chunk itself.
+  auto workers = std::vector<std::thread>{};
+  workers.reserve(chunk_count - 1U);
+  for (auto chunk = std::size_t{1U}; chunk < chunk_count; ++chunk)
+    workers.emplace_back(accum_chunk, chunk);
+  accum_chunk(0U);
+  for (auto &worker : workers)
+    worker.join();
+
+  auto total = Traits::zero;
+  for (const auto &partial : partials) {
+    if (partial.error)
+      std::rethrow_exception(partial.error);
+    accum_combine<Policy>(total, partial.value);
+  }
+  return total;
+}
+
 // Enabling and disabling function templates
 
 template <bool, typename T = void> struct EnableIfT {};
@@ -143,6 +277,129 @@ public:
   operator Container<U>() const;
 };
 
+// Example: Bulk relocation, copy and fill
+
+// Moving ranges of objects dispatches on their type properties. Emulating the
+// iterator tags, the tags for relocation form a hierarchy from the weakest to
+// the strongest guarantee, and the overloads of relocate_impl take the most
+// derived tag that they can exploit.
+struct RelocateByCopyTag {};
+struct RelocateByMoveTag : RelocateByCopyTag {};
+struct RelocateByBytesTag : RelocateByMoveTag {};
+
+// Like std::move_if_noexcept, objects are only copied if their move may throw
+// and they can be copied at all.
+template <typename T>
+using RelocationTag = std::conditional_t<
+    IsTriviallyRelocatable<T>, RelocateByBytesTag,
+    std::conditional_t<IsNothrowMoveConstructibleT<T>::value ||
+                           !std::is_copy_constructible_v<T>,
+                       RelocateByMoveTag, RelocateByCopyTag>>;
+
+// Moves the bytes of all objects at once. memmove allows the ranges to
+// overlap, e.g. when shifting elements within the same buffer.
+template <typename T>
+void relocate_impl(T *first, std::size_t n, T *dest, RelocateByBytesTag) {
+  if (n != 0U)
+    std::memmove(static_cast<void *>(dest), static_cast<const void *>(first),
+                 n * sizeof(T));
+}
+// Moves cannot throw, so the objects can be moved one after the other. Objects
+// that can only be moved are moved even if that may throw. If a move throws,
+// the objects moved so far are destroyed and the source stays initialized,
+// with its first objects in a moved-from state.
+template <typename T>
+void relocate_impl(T *first, std::size_t n, T *dest, RelocateByMoveTag) {
+  if constexpr (IsNothrowMoveConstructibleT<T>::value) {
+    for (std::size_t i = 0U; i < n; ++i) {
+      ::new (static_cast<void *>(dest + i)) T(std::move(first[i]));
+      first[i].~T();
+    }
+  } else {
+    std::uninitialized_move_n(first, n, dest);
+    std::destroy_n(first, n);
+  }
+}
+// Moves may throw (see std::move_if_noexcept), so the source is copied and
+// only destroyed once all copies succeeded. If a copy throws, the source
+// is left unchanged.
+template <typename T>
+void relocate_impl(T *first, std::size_t n, T *dest, RelocateByCopyTag) {
+  std::uninitialized_copy_n(first, n, dest);
+  std::destroy_n(first, n);
+}
+
+// Relocates the n objects at first into the uninitialized memory at dest.
+// Afterwards, the memory at first is uninitialized. Only trivially relocatable
+// types may relocate to an overlapping range, the others need the ranges to be
+// disjoint.
+template <typename T> void relocate_n(T *first, std::size_t n, T *dest) {
+  relocate_impl(first, n, dest, RelocationTag<T>{});
+}
+
+// The bytes of contiguous ranges of the same trivially copyable type can be
+// copied at once.
+template <typename InIter, typename OutIter>
+constexpr bool CopiesBytes =
+    IsContiguousIteratorT<InIter>::value &&
+    IsContiguousIteratorT<OutIter>::value &&
+    std::is_same_v<typename std::iterator_traits<InIter>::value_type,
+                   typename std::iterator_traits<OutIter>::value_type> &&
+    std::is_trivially_copyable_v<
+        typename std::iterator_traits<InIter>::value_type>;
+
+// Copy-assigns [first, last) to the initialized range at dest and returns its
+// end.
+template <typename InIter, typename OutIter>
+EnableIf<CopiesBytes<InIter, OutIter>, OutIter> bulk_copy(InIter first,
+                                                          InIter last,
+                                                          OutIter dest) {
+  const auto n = static_cast<std::size_t>(std::distance(first, last));
+  if (n != 0U)
+    std::memmove(std::addressof(*dest), std::addressof(*first),
+                 n * sizeof(*first));
+  return std::next(dest, static_cast<std::ptrdiff_t>(n));
+}
+template <typename InIter, typename OutIter>
+EnableIf<!CopiesBytes<InIter, OutIter>, OutIter> bulk_copy(InIter first,
+                                                           InIter last,
+                                                           OutIter dest) {
+  return std::copy(first, last, dest);
+}
+
+// Assigns value to all elements of [first, last). Contiguous ranges of
+// trivially copyable types whose value consists of a single repeated byte
+// (all byte-sized values, zero for most types) are filled with memset.
+template <typename Iter>
+constexpr bool FillsBytes =
+    IsContiguousIteratorT<Iter>::value &&
+    std::is_trivially_copyable_v<
+        typename std::iterator_traits<Iter>::value_type>;
+
+template <typename T> bool is_repeated_byte(const T &value) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, std::addressof(value), sizeof(T));
+  return std::all_of(bytes, bytes + sizeof(T),
+                     [&bytes](unsigned char byte) { return byte == bytes[0]; });
+}
+
+template <typename Iter, typename T>
+EnableIf<FillsBytes<Iter>> bulk_fill(Iter first, Iter last, const T &value) {
+  using ValueT = typename std::iterator_traits<Iter>::value_type;
+  const auto element = static_cast<ValueT>(value);
+  if (first == last || !is_repeated_byte(element)) {
+    std::fill(first, last, element);
+    return;
+  }
+  std::memset(std::addressof(*first),
+              *reinterpret_cast<const unsigned char *>(&element),
+              static_cast<std::size_t>(last - first) * sizeof(ValueT));
+}
+template <typename Iter, typename T>
+EnableIf<!FillsBytes<Iter>> bulk_fill(Iter first, Iter last, const T &value) {
+  std::fill(first, last, value);
+}
+
 // Class specialization
 
 template <typename T, typename = std::void_t<>>
@@ -153,16 +410,543 @@ struct IsHashable<
     : std::true_type {};
 template <typename T> constexpr auto IsHashableV = IsHashable<T>::value;
 
+// Example: Arena allocation
+
+// Containers that are built up and then thrown away as a whole (e.g. per
+// request or per frame) do not need to free their memory piece by piece. An
+// Arena hands out memory by bumping a pointer through large blocks and frees
+// all of it at once on release() or destruction. Memory given back by the
+// containers in between, e.g. the old table after a rehash, is not reused, so
+// reserving the final size upfront avoids wasting it. Not thread-safe.
+class Arena {
+public:
+  explicit Arena(std::size_t block_size = 1U << 16U) : block_size{block_size} {}
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena() { release(); }
+
+  void *allocate(std::size_t bytes, std::size_t align) {
+    auto offset = padding(align);
+    if (blocks == nullptr || current + offset + bytes > capacity) {
+      grow(bytes + align);
+      offset = padding(align);
+    }
+    auto *result = data() + current + offset;
+    current += offset + bytes;
+    return result;
+  }
+
+  // Frees all memory at once.
+  void release() noexcept {
+    while (blocks != nullptr)
+      ::operator delete(std::exchange(blocks, blocks->next));
+    current = capacity = 0U;
+  }
+
+private:
+  struct alignas(std::max_align_t) Block {
+    Block *next;
+  };
+
+  unsigned char *data() noexcept {
+    return reinterpret_cast<unsigned char *>(blocks + 1);
+  }
+
+  // Bytes to skip until the next address aligned to align.
+  std::size_t padding(std::size_t align) noexcept {
+    if (blocks == nullptr)
+      return 0U;
+    const auto address = reinterpret_cast<std::uintptr_t>(data() + current);
+    return (align - address % align) % align;
+  }
+
+  void grow(std::size_t min_size) {
+    const auto size = std::max(block_size, min_size);
+    auto *block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+    block->next = blocks;
+    blocks = block;
+    current = 0U;
+    capacity = size;
+  }
+
+  std::size_t block_size;
+  Block *blocks{nullptr};
+  // Offsets into the data of the newest block.
+  std::size_t current{0U};
+  std::size_t capacity{0U};
+};
+
+// Standard allocator that allocates from an Arena and never deallocates.
+template <typename T> class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena &arena) noexcept : arena{&arena} {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+      : arena{other.arena} {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *, std::size_t) noexcept {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const noexcept {
+    return arena == other.arena;
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+    return arena != other.arena;
+  }
+
+private:
+  template <typename U> friend class ArenaAllocator;
+  Arena *arena;
+};
+
 // We do not need to disable anything on the primary template as partial
 // specializations take precedence during matching.
-// May implement an ordered map type container.
-template <typename Key, typename Value, typename = void> class Dictionary {};
+// Implements an ordered map type container.
+//
+// Keys and values are kept in two vectors sorted by key (like std::flat_map).
+// Binary searches only touch the keys, which lie densely packed in memory,
+// instead of chasing the pointers of a node-based tree like std::map. Insertion
+// and erasure shift the elements behind them, which is cheap for the sizes a
+// dictionary usually has, as moving contiguous memory is much faster than
+// allocating and rebalancing nodes.
+template <typename Key, typename Value,
+          typename Allocator = std::allocator<std::pair<Key, Value>>,
+          typename = void>
+class Dictionary {
+private:
+  template <typename T>
+  using Rebind =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+public:
+  Dictionary() = default;
+  explicit Dictionary(const Allocator &allocator)
+      : keys(Rebind<Key>{allocator}), values(Rebind<Value>{allocator}) {}
+
+  std::size_t size() const noexcept { return keys.size(); }
+  bool empty() const noexcept { return keys.empty(); }
+
+  void clear() noexcept {
+    keys.clear();
+    values.clear();
+  }
+
+  void reserve(std::size_t capacity) {
+    keys.reserve(capacity);
+    values.reserve(capacity);
+  }
+
+  Value *find(const Key &key) noexcept {
+    const auto index = lower_bound(key);
+    return index != keys.size() && !(key < keys[index]) ? &values[index]
+                                                         : nullptr;
+  }
+  const Value *find(const Key &key) const noexcept {
+    return const_cast<Dictionary *>(this)->find(key);
+  }
+  bool contains(const Key &key) const noexcept { return find(key) != nullptr; }
+
+  // Inserts Value(args...) iff there is no entry for key yet. Returns the
+  // (possibly existing) value and whether it was inserted.
+  template <typename... Args>
+  std::pair<Value *, bool> try_emplace(const Key &key, Args &&...args) {
+    const auto index = lower_bound(key);
+    if (index != keys.size() && !(key < keys[index]))
+      return {&values[index], false};
+    const auto offset = static_cast<std::ptrdiff_t>(index);
+    values.emplace(values.begin() + offset, std::forward<Args>(args)...);
+    try {
+      keys.insert(keys.begin() + offset, key);
+    } catch (...) {
+      values.erase(values.begin() + offset);
+      throw;
+    }
+    return {&values[index], true};
+  }
+
+  Value &operator[](const Key &key) { return *try_emplace(key).first; }
+
+  bool erase(const Key &key) {
+    const auto index = lower_bound(key);
+    if (index == keys.size() || key < keys[index])
+      return false;
+    keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(index));
+    values.erase(values.begin() + static_cast<std::ptrdiff_t>(index));
+    return true;
+  }
+
+  // Visits all entries as f(key, value) in ascending order of keys.
+  template <typename F> void for_each(F &&f) const {
+    for (std::size_t i = 0U; i < keys.size(); ++i)
+      f(keys[i], values[i]);
+  }
+
+private:
+  // Branchless binary search. The loop always runs log2(size) times, so it
+  // does not suffer branch mispredictions and the compiler turns the
+  // comparison into a conditional move.
+  std::size_t lower_bound(const Key &key) const noexcept {
+    const auto *first = keys.data();
+    auto length = keys.size();
+    while (length > 1U) {
+      const auto half = length / 2U;
+      first = first[half - 1U] < key ? first + half : first;
+      length -= half;
+    }
+    const auto index = static_cast<std::size_t>(first - keys.data());
+    return index + (length == 1U && *first < key ? 1U : 0U);
+  }
+
+  std::vector<Key, Rebind<Key>> keys{};
+  std::vector<Value, Rebind<Value>> values{};
+};
+
+// Group of control bytes of the Swiss table below that are probed at once.
+// Every control byte describes one slot: CtrlEmpty, CtrlDeleted or, for full
+// slots, seven bits of the hash of their key (with the high bit clear). With
+// SSE2, comparing the control bytes of a whole group of 16 slots against
+// these bits is a single instruction, and a bitmask of the matching slots
+// tells which keys need to be compared at all.
+inline constexpr std::int8_t CtrlEmpty = -128;
+inline constexpr std::int8_t CtrlDeleted = -2;
+
+class SwissGroup {
+public:
+  static constexpr std::size_t width = 16U;
+
+  explicit SwissGroup(const std::int8_t *ctrl) noexcept {
+#if defined(__SSE2__)
+    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    std::copy(ctrl, ctrl + width, bytes);
+#endif
+  }
+
+  // Bitmask of the slots whose control byte is h2.
+  std::uint32_t match(std::int8_t h2) const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+#else
+    return mask([h2](std::int8_t ctrl) { return ctrl == h2; });
+#endif
+  }
+
+  std::uint32_t match_empty() const noexcept { return match(CtrlEmpty); }
+
+  // Both CtrlEmpty and CtrlDeleted have the high bit set.
+  std::uint32_t match_empty_or_deleted() const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+#else
+    return mask([](std::int8_t ctrl) { return ctrl < 0; });
+#endif
+  }
+
+private:
+#if defined(__SSE2__)
+  __m128i bytes;
+#else
+  template <typename Predicate>
+  std::uint32_t mask(Predicate predicate) const noexcept {
+    auto result = std::uint32_t{0U};
+    for (std::size_t i = 0U; i < width; ++i)
+      result |= static_cast<std::uint32_t>(predicate(bytes[i])) << i;
+    return result;
+  }
+
+  std::int8_t bytes[width];
+#endif
+};
+
+inline std::size_t lowest_bit_index(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+  return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+  auto index = std::size_t{0U};
+  for (; (mask & 1U) == 0U; mask >>= 1U)
+    ++index;
+  return index;
+#endif
+}
+
+// std::hash of integers is the identity, whose low and high bits are too
+// regular to split into a probe position and control bits. Multiplying by
+// 2^64 / golden ratio and folding the high half down spreads every input bit
+// over the whole result. 128-bit integers are a compiler extension, which
+// __extension__ keeps -Wpedantic from warning about.
+inline std::size_t swiss_mix(std::size_t hash) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 U128;
+  const auto product = static_cast<U128>(hash) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<std::size_t>(product ^ (product >> 64U));
+#else
+  hash *= static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+  return hash ^ (hash >> (sizeof(std::size_t) * 4U));
+#endif
+}
 
 // Note that we would also need to ensure mutual exclusivity for the conditions
 // of the partial specializations if there are multiple conditions.
-// May implement an unordered map type container.
-template <typename Key, typename Value>
-class Dictionary<Key, Value, EnableIf<IsHashableV<Key>>> {};
+// Implements an unordered map type container.
+//
+// Open-addressing hash table in the style of Abseil's Swiss tables. Slots are
+// stored in one flat array, split into groups of SwissGroup::width slots, with
+// a parallel array of control bytes. The hash selects the first group to probe
+// (h1) and the seven control bits (h2). Lookups probe whole groups at once and
+// only compare the keys of slots whose control bits match, which rarely miss.
+// A group with an empty slot ends the probe sequence. Groups are probed in
+// triangular steps, which visits every group of a power-of-two table.
+// Erasing leaves a tombstone (CtrlDeleted) only if the group is full, as only
+// then may probe sequences run through it.
+template <typename Key, typename Value, typename Allocator>
+class Dictionary<Key, Value, Allocator, EnableIf<IsHashableV<Key>>> {
+private:
+  using Slot = std::pair<Key, Value>;
+  using SlotAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using CtrlAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<std::int8_t>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+  using CtrlTraits = std::allocator_traits<CtrlAllocator>;
+
+public:
+  Dictionary() = default;
+  explicit Dictionary(const Allocator &allocator)
+      : slot_allocator{allocator}, ctrl_allocator{allocator} {}
+
+  Dictionary(const Dictionary &other)
+      : slot_allocator{SlotTraits::select_on_container_copy_construction(
+            other.slot_allocator)},
+        ctrl_allocator{CtrlTraits::select_on_container_copy_construction(
+            other.ctrl_allocator)} {
+    reserve(other.size());
+    other.for_each([this](const Key &key, const Value &value) {
+      insert_unique(hash_of(key), key, value);
+    });
+  }
+  Dictionary(Dictionary &&other) noexcept
+      : slot_allocator{other.slot_allocator},
+        ctrl_allocator{other.ctrl_allocator},
+        ctrl{std::exchange(other.ctrl, nullptr)},
+        slots{std::exchange(other.slots, nullptr)},
+        capacity{std::exchange(other.capacity, 0U)},
+        count{std::exchange(other.count, 0U)},
+        growth_left{std::exchange(other.growth_left, 0U)} {}
+  Dictionary &operator=(Dictionary other) noexcept {
+    swap(other);
+    return *this;
+  }
+  ~Dictionary() {
+    clear();
+    deallocate();
+  }
+
+  void swap(Dictionary &other) noexcept {
+    using std::swap;
+    swap(slot_allocator, other.slot_allocator);
+    swap(ctrl_allocator, other.ctrl_allocator);
+    swap(ctrl, other.ctrl);
+    swap(slots, other.slots);
+    swap(capacity, other.capacity);
+    swap(count, other.count);
+    swap(growth_left, other.growth_left);
+  }
+
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0U; }
+
+  void clear() noexcept {
+    for (std::size_t i = 0U; i < capacity; ++i) {
+      if (ctrl[i] >= 0)
+        SlotTraits::destroy(slot_allocator, slots + i);
+    }
+    std::fill(ctrl, ctrl + capacity, CtrlEmpty);
+    count = 0U;
+    growth_left = max_load(capacity);
+  }
+
+  // Makes room for at least capacity entries without rehashing.
+  void reserve(std::size_t min_count) {
+    auto slot_count = MinCapacity;
+    while (max_load(slot_count) < min_count)
+      slot_count *= 2U;
+    if (slot_count > capacity)
+      rehash(slot_count);
+  }
+
+  Value *find(const Key &key) noexcept {
+    const auto index = find_index(key, hash_of(key));
+    return index == npos ? nullptr : &slots[index].second;
+  }
+  const Value *find(const Key &key) const noexcept {
+    return const_cast<Dictionary *>(this)->find(key);
+  }
+  bool contains(const Key &key) const noexcept { return find(key) != nullptr; }
+
+  // Inserts Value(args...) iff there is no entry for key yet. Returns the
+  // (possibly existing) value and whether it was inserted.
+  template <typename... Args>
+  std::pair<Value *, bool> try_emplace(const Key &key, Args &&...args) {
+    const auto hash = hash_of(key);
+    if (const auto index = find_index(key, hash); index != npos)
+      return {&slots[index].second, false};
+    if (growth_left == 0U)
+      grow();
+    return {insert_unique(hash, key, std::forward<Args>(args)...), true};
+  }
+
+  Value &operator[](const Key &key) { return *try_emplace(key).first; }
+
+  bool erase(const Key &key) {
+    const auto index = find_index(key, hash_of(key));
+    if (index == npos)
+      return false;
+    SlotTraits::destroy(slot_allocator, slots + index);
+    const auto group = index & ~(SwissGroup::width - 1U);
+    if (SwissGroup{ctrl + group}.match_empty() != 0U) {
+      ctrl[index] = CtrlEmpty;
+      ++growth_left;
+    } else {
+      ctrl[index] = CtrlDeleted;
+    }
+    --count;
+    return true;
+  }
+
+  // Visits all entries as f(key, value) in unspecified order.
+  template <typename F> void for_each(F &&f) const {
+    for (std::size_t i = 0U; i < capacity; ++i) {
+      if (ctrl[i] >= 0)
+        f(static_cast<const Key &>(slots[i].first), slots[i].second);
+    }
+  }
+
+private:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+  static constexpr std::size_t MinCapacity = SwissGroup::width;
+
+  // Maximum load factor of 7/8. Probing groups keeps probe sequences short
+  // even at high load.
+  static constexpr std::size_t max_load(std::size_t slot_count) noexcept {
+    return slot_count - slot_count / 8U;
+  }
+
+  static std::size_t hash_of(const Key &key) noexcept {
+    return swiss_mix(std::hash<Key>{}(key));
+  }
+  static std::int8_t h2(std::size_t hash) noexcept {
+    return static_cast<std::int8_t>(hash & 0x7FU);
+  }
+  std::size_t h1(std::size_t hash) const noexcept {
+    return (hash >> 7U) & (capacity / SwissGroup::width - 1U);
+  }
+
+  std::size_t find_index(const Key &key, std::size_t hash) const noexcept {
+    if (capacity == 0U)
+      return npos;
+    const auto group_mask = capacity / SwissGroup::width - 1U;
+    auto group = h1(hash);
+    for (std::size_t step = 1U;; ++step) {
+      const auto *group_ctrl = ctrl + group * SwissGroup::width;
+      const auto probe = SwissGroup{group_ctrl};
+      for (auto match = probe.match(h2(hash)); match != 0U;
+           match &= match - 1U) {
+        const auto index = group * SwissGroup::width + lowest_bit_index(match);
+        if (slots[index].first == key)
+          return index;
+      }
+      if (probe.match_empty() != 0U)
+        return npos;
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Inserts an entry for a key that is not in the table yet.
+  template <typename K, typename... Args>
+  Value *insert_unique(std::size_t hash, K &&key, Args &&...args) {
+    const auto group_mask = capacity / SwissGroup::width - 1U;
+    auto group = h1(hash);
+    for (std::size_t step = 1U;; ++step) {
+      const auto free =
+          SwissGroup{ctrl + group * SwissGroup::width}.match_empty_or_deleted();
+      if (free != 0U) {
+        const auto index = group * SwissGroup::width + lowest_bit_index(free);
+        SlotTraits::construct(
+            slot_allocator, slots + index, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        if (ctrl[index] == CtrlEmpty)
+          --growth_left;
+        ctrl[index] = h2(hash);
+        ++count;
+        return &slots[index].second;
+      }
+      group = (group + step) & group_mask;
+    }
+  }
+
+  // Doubles the table unless at least half of the load is tombstones, which
+  // a rehash to the same size clears.
+  void grow() {
+    if (capacity == 0U)
+      rehash(MinCapacity);
+    else if (count <= max_load(capacity) / 2U)
+      rehash(capacity);
+    else
+      rehash(2U * capacity);
+  }
+
+  void rehash(std::size_t slot_count) {
+    auto *new_ctrl = CtrlTraits::allocate(ctrl_allocator, slot_count);
+    Slot *new_slots = nullptr;
+    try {
+      new_slots = SlotTraits::allocate(slot_allocator, slot_count);
+    } catch (...) {
+      CtrlTraits::deallocate(ctrl_allocator, new_ctrl, slot_count);
+      throw;
+    }
+    std::fill(new_ctrl, new_ctrl + slot_count, CtrlEmpty);
+    auto *old_ctrl = std::exchange(ctrl, new_ctrl);
+    auto *old_slots = std::exchange(slots, new_slots);
+    const auto old_capacity = std::exchange(capacity, slot_count);
+    count = 0U;
+    growth_left = max_load(slot_count);
+    for (std::size_t i = 0U; i < old_capacity; ++i) {
+      if (old_ctrl[i] >= 0) {
+        auto &slot = old_slots[i];
+        insert_unique(hash_of(slot.first), std::move(slot.first),
+                      std::move(slot.second));
+        SlotTraits::destroy(slot_allocator, old_slots + i);
+      }
+    }
+    if (old_capacity != 0U) {
+      CtrlTraits::deallocate(ctrl_allocator, old_ctrl, old_capacity);
+      SlotTraits::deallocate(slot_allocator, old_slots, old_capacity);
+    }
+  }
+
+  void deallocate() noexcept {
+    if (capacity == 0U)
+      return;
+    CtrlTraits::deallocate(ctrl_allocator, ctrl, capacity);
+    SlotTraits::deallocate(slot_allocator, slots, capacity);
+  }
+
+  SlotAllocator slot_allocator{};
+  CtrlAllocator ctrl_allocator{};
+  std::int8_t *ctrl{nullptr};
+  Slot *slots{nullptr};
+  std::size_t capacity{0U};
+  std::size_t count{0U};
+  std::size_t growth_left{0U};
+};
 
 // Tag dispatching for class templates is also possible. Emulating overload
 // resolution for the partial class specializations (akin to advance_dispatch
@@ -175,26 +959,21 @@ class Dictionary<Key, Value, EnableIf<IsHashableV<Key>>> {};
 // can be achieved by encoding every operation that the template performs on its
 // arguments as part of an EnableIf condition.
 
-// Check if operator<(T1, T2) exists.
-template <typename T1, typename T2, typename = std::void_t<>>
-struct HasLess : std::false_type {};
+// Operation that yields the return type of operator<(T1, T2).
 template <typename T1, typename T2>
-struct HasLess<T1, T2,
-               std::void_t<decltype(std::declval<T1>() < std::declval<T2>())>>
-    : std::true_type {};
+using LessOp = decltype(std::declval<T1>() < std::declval<T2>());
+
+// Check if operator<(T1, T2) exists.
+template <typename T1, typename T2> using HasLess = IsDetectedT<LessOp, T1, T2>;
 
 // Deduce the return type of operator<(T1, T2).
-template <typename T1, typename T2, bool HasLess> struct LessResultImpl {
-  using Type = decltype(std::declval<T1>() < std::declval<T2>());
-};
-template <typename T1, typename T2> struct LessResultImpl<T1, T2, false> {};
 template <typename T1, typename T2>
-struct LessResultT : public LessResultImpl<T1, T2, HasLess<T1, T2>::value> {};
+using LessResultT = DetectedResultT<LessOp, T1, T2>;
 
-// We do this two-step process (check if operation exists, determine return
-// type) to provide a SFINAE-friendly trait. This is a trait that should not
-// fail to instantiate given reasonable arguments. More information can be found
-// in the discussion of PlusResult in Chapter 19.
+// The check if the operation exists and the return type share the probe of
+// DetectorT to provide a SFINAE-friendly trait. This is a trait that should
+// not fail to instantiate given reasonable arguments. More information can be
+// found in the discussion of PlusResult in Chapter 19.
 template <typename T1, typename T2>
 using LessResult = typename LessResultT<T1, T2>::Type;
 
@@ -1,3 +1,181 @@
 #include "chapter21_templates_and_inheritance.hpp"
+#include "chapter11_generic_libraries.hpp"
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
-int main() { return 0; }
+// Bidirectional iterator over a std::list, built from increment(),
+// decrement(), equals() and dereference().
+class ListIterator : public BidirectionalIteratorFacade<ListIterator, int> {
+private:
+  std::list<int>::iterator current{};
+
+public:
+  ListIterator(std::list<int>::iterator current) : current{current} {}
+
+  int &dereference() const { return *current; }
+  void increment() { ++current; }
+  void decrement() { --current; }
+  bool equals(const ListIterator &other) const {
+    return current == other.current;
+  }
+};
+
+struct Tracked : ConcurrentObjectCounter<Tracked> {};
+struct Untracked : ConcurrentObjectCounter<Untracked, false> {
+  int value;
+};
+
+int main() {
+  // Live objects counted per thread.
+  static_assert(sizeof(Untracked) == sizeof(int));
+  static_assert(Untracked::live() == 0U);
+  if constexpr (ObjectCountingEnabled) {
+    auto keep = std::vector<Tracked>(10U);
+    assert(Tracked::live() == 10U);
+    assert(Tracked::thread_high_water_mark() == 10U);
+
+    // Every thread peaks at 1000 objects, destroys them and leaves another
+    // 100 behind that outlive the thread.
+    auto survivors = std::vector<std::vector<Tracked>>(4U);
+    auto threads = std::vector<std::thread>{};
+    for (auto &kept : survivors)
+      threads.emplace_back([&kept] {
+        { const auto peak = std::vector<Tracked>(1000U); }
+        kept.resize(100U);
+        assert(Tracked::thread_high_water_mark() == 1000U);
+      });
+    for (auto &thread : threads)
+      thread.join();
+    assert(Tracked::live() == 10U + 4U * 100U);
+
+    // Destroyed on another thread than they were created on.
+    survivors.clear();
+    keep.clear();
+    assert(Tracked::live() == 0U);
+    // Only the sums live() returned count, not the peak of up to 4010 objects
+    // while the threads were running.
+    assert(Tracked::observed_peak() == 410U);
+  }
+
+  // Iterator facades for the stronger categories.
+  {
+    static_assert(std::is_same_v<
+                  std::iterator_traits<ListIterator>::iterator_category,
+                  std::bidirectional_iterator_tag>);
+    static_assert(std::is_same_v<
+                  std::iterator_traits<StridedIterator<int>>::iterator_category,
+                  std::random_access_iterator_tag>);
+    static_assert(!IsContiguousIteratorT<StridedIterator<int>>::value);
+    static_assert(IsContiguousIteratorT<ArrayIterator<int>>::value);
+    static_assert(UseVectorizedAccum<ArrayIterator<const int>,
+                                     AccumulationTraits<int>, true>);
+
+    auto list = std::list<int>{1, 2, 3};
+    const auto last = ListIterator{list.end()};
+    assert(*std::prev(last) == 3 && *std::prev(last, 2) == 2);
+    auto reversed = std::vector<int>(std::make_reverse_iterator(last),
+                                     std::make_reverse_iterator(
+                                         ListIterator{list.begin()}));
+    assert((reversed == std::vector<int>{3, 2, 1}));
+
+    // Sorts the second column of a row-major 4x3 matrix. advance_dispatch
+    // jumps in O(1) as the iterator is tagged random access.
+    int matrix[4][3] = {{0, 4, 0}, {0, 2, 0}, {0, 3, 0}, {0, 1, 0}};
+    const auto column = StridedIterator<int>{&matrix[0][1], 3};
+    std::sort(column, column + 4);
+    assert(matrix[0][1] == 1 && matrix[3][1] == 4 && matrix[0][2] == 0);
+    auto it = column;
+    advance_dispatch(it, 2);
+    assert(*it == 3 && it - column == 2 && column[2] == 3);
+    assert(column < it && it >= column && !(it <= column));
+
+    // accum and foreach loop over the pointers behind contiguous iterators.
+    const int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const auto first = ArrayIterator<const int>{values};
+    const auto end = first + 9;
+    assert((accum<ArrayIterator<const int>, SumPolicy>(first, end) == 45));
+    auto sum = 0;
+    foreach (first, end, [&sum](int i) { sum += i; })
+      ;
+    assert(sum == 45 && end - first == 9 && end[-1] == 9);
+    assert(std::count_if(first, end, [](int i) { return i % 2 == 0; }) == 4);
+  }
+
+  // Pool allocated linked list. Nodes allocated in sequence are adjacent.
+  {
+    auto list = PooledLinkedList<int>{};
+    for (auto i = 0; i < 1000; ++i)
+      list.push_back(i);
+    list.push_front(-1);
+    assert(list.size() == 1001U);
+    assert(list.front() == -1);
+    assert(std::accumulate(list.begin(), list.end(), 0) == 999 * 1000 / 2 - 1);
+    list.pop_front();
+    assert(*list.begin() == 0);
+
+    auto copy = list;
+    auto moved = std::move(list);
+    assert(list.empty() && moved.size() == 1000U && copy.size() == 1000U);
+    assert(std::equal(copy.begin(), copy.end(), moved.begin()));
+    list = copy;
+    copy = std::move(moved);
+    assert(list.size() == 1000U && copy.size() == 1000U && moved.empty());
+
+    auto resource = PoolAllocator<int>{};
+    const auto rebound = PoolAllocator<LinkedListNode<int>>{resource};
+    assert(rebound == resource && rebound != PoolAllocator<int>{});
+  }
+
+  // Unrolled linked list with small nodes, so that pushing to either end
+  // spills into new nodes.
+  {
+    auto list =
+        UnrolledLinkedList<std::string, PoolAllocator<std::string>, 4U>{};
+    for (auto i = 0; i < 10; ++i)
+      list.push_back(std::to_string(i));
+    for (auto i = 1; i <= 5; ++i)
+      list.emplace_front(i, 'x');
+    assert(list.size() == 15U);
+    assert(list.front() == "xxxxx");
+
+    auto joined = std::string{};
+    for (const auto &s : list)
+      joined += s;
+    assert(joined == "xxxxxxxxxxxxxxx0123456789");
+
+    for (auto i = 0; i < 6; ++i)
+      list.pop_front();
+    assert(list.front() == "1" && list.size() == 9U);
+
+    auto copy = list;
+    assert(std::equal(copy.begin(), copy.end(), list.begin()));
+    assert(list.begin()->size() == 1U);
+    copy = std::move(list);
+    list = copy;
+    assert(list.size() == 9U && std::equal(copy.begin(), copy.end(),
+                                           list.begin()));
+
+    // A throwing constructor leaves no empty node behind
+    auto strings =
+        UnrolledLinkedList<std::string, PoolAllocator<std::string>, 4U>{};
+    try {
+      strings.emplace_back(std::string::npos, 'x');
+    } catch (const std::length_error &) {
+    }
+    assert(strings.empty() && strings.begin() == strings.end());
+    strings.push_back("a");
+    assert(strings.front() == "a" && strings.size() == 1U);
+  }
+
+  static_assert(UnrolledNodeCapacity<int> == 60U);
+  static_assert(sizeof(UnrolledListNode<int, UnrolledNodeCapacity<int>>) <=
+                UnrolledNodeBytes);
+
+  return 0;
+}
@@ -1,8 +1,19 @@
 #ifndef CPP_TEMPLATES_CHAPTER21_TEMPLATES_AND_INHERITANCE
 #define CPP_TEMPLATES_CHAPTER21_TEMPLATES_AND_INHERITANCE
 
+#include "chapter20_overloading_on_type_properties.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 // Curiously Recurring Template Pattern (CRTP)
 // Pass derived class as a template argument to one of its base classes.
@@ -40,6 +51,138 @@ template <typename T> class Countable : public ObjectCounter<Countable<T>> {};
 // Since live is public and static, we can query the count like this:
 // const auto live_countable_chars = Countable<char>::live();
 
+// Example: Count live objects of type on multiple threads.
+
+// ObjectCounter races as soon as objects are created or destroyed on more than
+// one thread. Making count atomic would fix that, but then every constructor
+// and destructor on every core writes the same cache line.
+// ConcurrentObjectCounter gives every thread a counter of its own on a cache
+// line of its own instead. Only the owning thread writes its counter, so a
+// relaxed load and store suffice. live() sums up all counters under a lock,
+// which makes it the expensive operation. The counters of exited threads are
+// folded into a retired count and recycled for new threads.
+//
+// The sum is exact while no other thread is counting. Otherwise it may miss
+// the latest updates of other threads, so objects constructed on one thread
+// and destroyed on another may briefly be counted as -1, which is clamped.
+// observed_peak() is the largest sum any call of live() has returned. It is
+// sampled, so it misses peaks between two calls and can be far below the
+// actual peak. thread_high_water_mark() tracks the peak of the calling
+// thread's own counter exactly.
+//
+// Counting is removed entirely by compiling with
+// -DCPP_TEMPLATES_OBJECT_COUNTING=0 or per type with Enabled = false.
+#ifndef CPP_TEMPLATES_OBJECT_COUNTING
+#define CPP_TEMPLATES_OBJECT_COUNTING 1
+#endif
+inline constexpr bool ObjectCountingEnabled =
+    CPP_TEMPLATES_OBJECT_COUNTING != 0;
+
+template <typename T, bool Enabled = ObjectCountingEnabled>
+class ConcurrentObjectCounter {
+protected:
+  ConcurrentObjectCounter() { add(1); }
+  ConcurrentObjectCounter(const ConcurrentObjectCounter &) { add(1); }
+  ConcurrentObjectCounter(ConcurrentObjectCounter &&) { add(1); }
+  ConcurrentObjectCounter &operator=(const ConcurrentObjectCounter &) = default;
+  ConcurrentObjectCounter &operator=(ConcurrentObjectCounter &&) = default;
+  ~ConcurrentObjectCounter() { add(-1); }
+
+public:
+  static std::size_t live() {
+    auto &registry = get_registry();
+    const auto lock = std::lock_guard{registry.mutex};
+    auto total = registry.retired;
+    for (const auto &shard : registry.shards)
+      total += shard->count.load(std::memory_order_relaxed);
+    const auto result = static_cast<std::size_t>(std::max<Count>(total, 0));
+    registry.observed_peak = std::max(registry.observed_peak, result);
+    return result;
+  }
+
+  static std::size_t observed_peak() {
+    auto &registry = get_registry();
+    const auto lock = std::lock_guard{registry.mutex};
+    return registry.observed_peak;
+  }
+
+  static std::size_t thread_high_water_mark() {
+    return static_cast<std::size_t>(
+        local_shard().peak.load(std::memory_order_relaxed));
+  }
+
+private:
+  using Count = std::ptrdiff_t;
+
+  struct alignas(CacheLineSize) Shard {
+    std::atomic<Count> count{0};
+    std::atomic<Count> peak{0};
+  };
+
+  struct Registry {
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<Shard>> shards{};
+    std::vector<Shard *> unused{};
+    Count retired{0};
+    std::size_t observed_peak{0U};
+  };
+
+  // Function-local, so that it is initialized before objects of static storage
+  // duration in other translation units may use it.
+  static Registry &get_registry() {
+    static auto registry = Registry{};
+    return registry;
+  }
+
+  // Leases a shard to a thread for its lifetime.
+  struct ShardLease {
+    Shard *shard{nullptr};
+
+    ShardLease() {
+      auto &registry = get_registry();
+      const auto lock = std::lock_guard{registry.mutex};
+      if (registry.unused.empty()) {
+        registry.shards.push_back(std::make_unique<Shard>());
+        shard = registry.shards.back().get();
+      } else {
+        shard = registry.unused.back();
+        registry.unused.pop_back();
+      }
+    }
+    ShardLease(const ShardLease &) = delete;
+    ShardLease &operator=(const ShardLease &) = delete;
+    ~ShardLease() {
+      auto &registry = get_registry();
+      const auto lock = std::lock_guard{registry.mutex};
+      registry.retired += shard->count.exchange(0, std::memory_order_relaxed);
+      shard->peak.store(0, std::memory_order_relaxed);
+      registry.unused.push_back(shard);
+    }
+  };
+
+  static Shard &local_shard() {
+    thread_local auto lease = ShardLease{};
+    return *lease.shard;
+  }
+
+  static void add(Count n) {
+    auto &shard = local_shard();
+    const auto count = shard.count.load(std::memory_order_relaxed) + n;
+    shard.count.store(count, std::memory_order_relaxed);
+    if (count > shard.peak.load(std::memory_order_relaxed))
+      shard.peak.store(count, std::memory_order_relaxed);
+  }
+};
+
+// Disabled counter. Empty, so the empty base optimization removes it from
+// every object, and its queries are constant zero.
+template <typename T> class ConcurrentObjectCounter<T, false> {
+public:
+  static constexpr std::size_t live() { return 0U; }
+  static constexpr std::size_t observed_peak() { return 0U; }
+  static constexpr std::size_t thread_high_water_mark() { return 0U; }
+};
+
 // Example: Operator implementations
 
 // Factor behavior into base class while retaining the identity of the derived
@@ -85,6 +228,7 @@ public:
   // functions dereference(), increment() and equals() that must be implemented
   // by Derived.
   reference operator*() const { return as_derived().dereference(); }
+  pointer operator->() const { return std::addressof(**this); }
   Derived &operator++() {
     as_derived().increment();
     return as_derived();
@@ -98,8 +242,12 @@ public:
                          const ForwardIteratorFacade &rhs) {
     return lhs.as_derived().equals(rhs.as_derived());
   }
+  friend bool operator!=(const ForwardIteratorFacade &lhs,
+                         const ForwardIteratorFacade &rhs) {
+    return !(lhs == rhs);
+  }
 
-private:
+protected:
   // Access the derived class.
   Derived &as_derived() { return *static_cast<Derived *>(this); }
   const Derived &as_derived() const {
@@ -138,6 +286,589 @@ public:
   }
 };
 
+// The facades for the stronger iterator categories work the same way. Their
+// iterator_category tells tag dispatching like advance_dispatch in chapter 20
+// and the standard algorithms which operations are cheap.
+
+// Additionally requires decrement() from Derived.
+template <typename Derived, typename Value, typename Reference = Value &,
+          typename Distance = std::ptrdiff_t>
+class BidirectionalIteratorFacade
+    : public ForwardIteratorFacade<Derived, Value, Reference, Distance> {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+
+  Derived &operator--() {
+    this->as_derived().decrement();
+    return this->as_derived();
+  }
+  Derived operator--(int) {
+    const auto result = this->as_derived();
+    this->as_derived().decrement();
+    return result;
+  }
+};
+
+// Implements the full random access iterator interface in terms of the
+// functions dereference(), advance(n) and distance_to(other) that must be
+// implemented by Derived, where it.distance_to(other) == other - it.
+template <typename Derived, typename Value, typename Reference = Value &,
+          typename Distance = std::ptrdiff_t>
+class RandomAccessIteratorFacade {
+public:
+  using value_type = typename std::decay_t<Value>;
+  using reference = Reference;
+  using pointer = Value *;
+  using difference_type = Distance;
+  using iterator_category = std::random_access_iterator_tag;
+
+  reference operator*() const { return as_derived().dereference(); }
+  pointer operator->() const { return std::addressof(**this); }
+  reference operator[](difference_type n) const { return *(as_derived() + n); }
+
+  Derived &operator+=(difference_type n) {
+    as_derived().advance(n);
+    return as_derived();
+  }
+  Derived &operator-=(difference_type n) { return *this += -n; }
+  Derived &operator++() { return *this += 1; }
+  Derived &operator--() { return *this -= 1; }
+  Derived operator++(int) {
+    const auto result = as_derived();
+    ++*this;
+    return result;
+  }
+  Derived operator--(int) {
+    const auto result = as_derived();
+    --*this;
+    return result;
+  }
+
+  friend Derived operator+(Derived it, difference_type n) { return it += n; }
+  friend Derived operator+(difference_type n, Derived it) { return it += n; }
+  friend Derived operator-(Derived it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const Derived &lhs, const Derived &rhs) {
+    return rhs.distance_to(lhs);
+  }
+
+  friend bool operator==(const Derived &lhs, const Derived &rhs) {
+    return lhs.distance_to(rhs) == 0;
+  }
+  friend bool operator!=(const Derived &lhs, const Derived &rhs) {
+    return !(lhs == rhs);
+  }
+  friend bool operator<(const Derived &lhs, const Derived &rhs) {
+    return lhs.distance_to(rhs) > 0;
+  }
+  friend bool operator>(const Derived &lhs, const Derived &rhs) {
+    return rhs < lhs;
+  }
+  friend bool operator<=(const Derived &lhs, const Derived &rhs) {
+    return !(rhs < lhs);
+  }
+  friend bool operator>=(const Derived &lhs, const Derived &rhs) {
+    return !(lhs < rhs);
+  }
+
+protected:
+  Derived &as_derived() { return *static_cast<Derived *>(this); }
+  const Derived &as_derived() const {
+    return *static_cast<const Derived *>(this);
+  }
+};
+
+// Random access iterator whose elements are adjacent in memory, so that
+// [&*first, &*first + (last - first)) is the same range as [first, last).
+// C++17 has no tag for this, so the iterator declares is_contiguous_iterator,
+// which IsContiguousIteratorT in chapter 19 detects. Algorithms like accum and
+// foreach then loop over plain pointers instead.
+template <typename Derived, typename Value, typename Distance = std::ptrdiff_t>
+class ContiguousIteratorFacade
+    : public RandomAccessIteratorFacade<Derived, Value, Value &, Distance> {
+public:
+  static constexpr bool is_contiguous_iterator = true;
+#if defined(__cpp_lib_concepts)
+  using iterator_concept = std::contiguous_iterator_tag;
+  using element_type = Value;
+#endif
+};
+
+// Contiguous iterator over an array.
+template <typename T>
+class ArrayIterator : public ContiguousIteratorFacade<ArrayIterator<T>, T> {
+private:
+  T *current{nullptr};
+
+public:
+  ArrayIterator(T *current = nullptr) : current{current} {}
+
+  T &dereference() const { return *current; }
+  void advance(std::ptrdiff_t n) { current += n; }
+  std::ptrdiff_t distance_to(const ArrayIterator &other) const {
+    return other.current - current;
+  }
+};
+
+// Random access iterator over every stride-th element of an array, e.g. a
+// column of a row-major matrix. Not contiguous for strides other than one.
+template <typename T>
+class StridedIterator
+    : public RandomAccessIteratorFacade<StridedIterator<T>, T> {
+private:
+  T *current{nullptr};
+  std::ptrdiff_t stride{1};
+
+public:
+  StridedIterator(T *current = nullptr, std::ptrdiff_t stride = 1)
+      : current{current}, stride{stride} {}
+
+  T &dereference() const { return *current; }
+  void advance(std::ptrdiff_t n) { current += n * stride; }
+  std::ptrdiff_t distance_to(const StridedIterator &other) const {
+    return (other.current - current) / stride;
+  }
+};
+
+// Example: Pool allocated linked lists
+
+// Allocating every node of a list on its own costs a call to the general
+// purpose allocator per insertion and scatters the nodes all over the heap,
+// so traversing the list misses the cache at every node. SlabPool hands out
+// blocks of a single size from large slabs instead: allocation and
+// deallocation just pop and push a free list, and nodes allocated one after
+// the other are adjacent in memory.
+class SlabPool {
+public:
+  static constexpr std::size_t BlockAlign = alignof(std::max_align_t);
+
+  explicit SlabPool(std::size_t block_size, std::size_t blocks_per_slab = 256U)
+      : block_size{(std::max(block_size, sizeof(FreeBlock)) + BlockAlign - 1U) /
+                   BlockAlign * BlockAlign},
+        blocks_per_slab{blocks_per_slab} {}
+
+  SlabPool(const SlabPool &) = delete;
+  SlabPool &operator=(const SlabPool &) = delete;
+  SlabPool(SlabPool &&other) noexcept
+      : block_size{other.block_size}, blocks_per_slab{other.blocks_per_slab},
+        free_list{std::exchange(other.free_list, nullptr)},
+        slabs{std::move(other.slabs)} {}
+  SlabPool &operator=(SlabPool &&) = delete;
+
+  ~SlabPool() {
+    for (auto *slab : slabs)
+      ::operator delete(slab, std::align_val_t{BlockAlign});
+  }
+
+  std::size_t size() const noexcept { return block_size; }
+
+  void *allocate() {
+    if (free_list == nullptr)
+      grow();
+    return std::exchange(free_list, free_list->next);
+  }
+
+  void deallocate(void *block) noexcept {
+    free_list = ::new (block) FreeBlock{free_list};
+  }
+
+private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  // Threads the blocks of a new slab onto the free list in reverse, so that
+  // they are handed out in ascending address order.
+  void grow() {
+    slabs.reserve(slabs.size() + 1U);
+    auto *slab = static_cast<unsigned char *>(::operator new(
+        block_size * blocks_per_slab, std::align_val_t{BlockAlign}));
+    slabs.push_back(slab);
+    for (auto block = blocks_per_slab; block-- > 0U;)
+      deallocate(slab + block * block_size);
+  }
+
+  std::size_t block_size;
+  std::size_t blocks_per_slab;
+  FreeBlock *free_list{nullptr};
+  std::vector<void *> slabs{};
+};
+
+// Serves small allocations from one SlabPool per size class (multiples of
+// SlabPool::BlockAlign) and forwards larger or over-aligned ones to operator
+// new. Not thread-safe.
+class PoolResource {
+public:
+  static constexpr std::size_t MaxPooledSize = 256U;
+
+  explicit PoolResource(std::size_t blocks_per_slab = 256U) {
+    pools.reserve(MaxPooledSize / SlabPool::BlockAlign);
+    for (auto size = SlabPool::BlockAlign; size <= MaxPooledSize;
+         size += SlabPool::BlockAlign)
+      pools.emplace_back(size, blocks_per_slab);
+  }
+
+  void *allocate(std::size_t bytes, std::size_t align) {
+    if (auto *pool = pool_for(bytes, align))
+      return pool->allocate();
+    return ::operator new(bytes, std::align_val_t{align});
+  }
+
+  void deallocate(void *p, std::size_t bytes, std::size_t align) noexcept {
+    if (auto *pool = pool_for(bytes, align))
+      pool->deallocate(p);
+    else
+      ::operator delete(p, std::align_val_t{align});
+  }
+
+private:
+  SlabPool *pool_for(std::size_t bytes, std::size_t align) noexcept {
+    if (bytes == 0U || bytes > MaxPooledSize || align > SlabPool::BlockAlign)
+      return nullptr;
+    return &pools[(bytes - 1U) / SlabPool::BlockAlign];
+  }
+
+  std::vector<SlabPool> pools{};
+};
+
+// Standard allocator drawing single objects from a shared PoolResource.
+// Rebound copies share the resource, so they compare equal and can deallocate
+// each other's memory as the allocator requirements demand.
+template <typename T> class PoolAllocator {
+public:
+  using value_type = T;
+
+  PoolAllocator() : pools{std::make_shared<PoolResource>()} {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) noexcept
+      : pools{other.pools} {}
+
+  PoolResource *resource() const noexcept { return pools.get(); }
+
+  T *allocate(std::size_t n) {
+    if (n == 1U)
+      return static_cast<T *>(pools->allocate(sizeof(T), alignof(T)));
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    if (n == 1U)
+      pools->deallocate(p, sizeof(T), alignof(T));
+    else
+      ::operator delete(p, std::align_val_t{alignof(T)});
+  }
+
+private:
+  template <typename U> friend class PoolAllocator;
+  std::shared_ptr<PoolResource> pools;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &lhs,
+                const PoolAllocator<U> &rhs) noexcept {
+  return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &lhs,
+                const PoolAllocator<U> &rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+// Allocator-aware singly-linked list of LinkedListNodes, iterated by the
+// LinkedListNodeIterator from above. With the default PoolAllocator, its nodes
+// come from a SlabPool.
+template <typename T, typename Allocator = PoolAllocator<T>>
+class PooledLinkedList {
+private:
+  using Node = LinkedListNode<T>;
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+public:
+  using value_type = T;
+  using iterator = LinkedListNodeIterator<T>;
+
+  PooledLinkedList() = default;
+  explicit PooledLinkedList(const Allocator &allocator)
+      : allocator{allocator} {}
+
+  PooledLinkedList(const PooledLinkedList &other)
+      : allocator{NodeTraits::select_on_container_copy_construction(
+            other.allocator)} {
+    for (auto *node = other.head; node != nullptr; node = node->next)
+      push_back(node->value);
+  }
+  PooledLinkedList(PooledLinkedList &&other) noexcept
+      : allocator{other.allocator}, head{std::exchange(other.head, nullptr)},
+        tail{std::exchange(other.tail, nullptr)},
+        count{std::exchange(other.count, 0U)} {}
+  // Copy-and-swap: other is copied or moved, so assignment takes over its
+  // nodes together with the allocator they came from.
+  PooledLinkedList &operator=(PooledLinkedList other) noexcept {
+    swap(*this, other);
+    return *this;
+  }
+  friend void swap(PooledLinkedList &lhs, PooledLinkedList &rhs) noexcept {
+    using std::swap;
+    swap(lhs.allocator, rhs.allocator);
+    swap(lhs.head, rhs.head);
+    swap(lhs.tail, rhs.tail);
+    swap(lhs.count, rhs.count);
+  }
+
+  ~PooledLinkedList() { clear(); }
+
+  iterator begin() noexcept { return iterator{head}; }
+  iterator end() noexcept { return iterator{}; }
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0U; }
+  T &front() noexcept { return head->value; }
+
+  template <typename... Args> T &emplace_front(Args &&...args) {
+    auto *node = create(std::forward<Args>(args)...);
+    node->next = head;
+    head = node;
+    if (tail == nullptr)
+      tail = node;
+    ++count;
+    return node->value;
+  }
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    auto *node = create(std::forward<Args>(args)...);
+    (tail == nullptr ? head : tail->next) = node;
+    tail = node;
+    ++count;
+    return node->value;
+  }
+  void push_front(const T &value) { emplace_front(value); }
+  void push_back(const T &value) { emplace_back(value); }
+
+  void pop_front() noexcept {
+    auto *node = std::exchange(head, head->next);
+    if (head == nullptr)
+      tail = nullptr;
+    --count;
+    destroy(node);
+  }
+
+  void clear() noexcept {
+    while (head != nullptr)
+      pop_front();
+  }
+
+private:
+  template <typename... Args> Node *create(Args &&...args) {
+    auto *node = NodeTraits::allocate(allocator, 1U);
+    try {
+      ::new (static_cast<void *>(node)) Node{T(std::forward<Args>(args)...)};
+    } catch (...) {
+      NodeTraits::deallocate(allocator, node, 1U);
+      throw;
+    }
+    return node;
+  }
+
+  // ~LinkedListNode would delete the rest of the list.
+  void destroy(Node *node) noexcept {
+    node->next = nullptr;
+    node->~Node();
+    NodeTraits::deallocate(allocator, node, 1U);
+  }
+
+  NodeAllocator allocator{};
+  Node *head{nullptr};
+  Node *tail{nullptr};
+  std::size_t count{0U};
+};
+
+// Unrolled linked list. Every node stores up to Capacity elements in an array,
+// which divides the number of nodes (and thereby allocations and pointer
+// chasing) by Capacity. Traversal walks through the elements of a node
+// sequentially, which the hardware prefetcher recognizes. By default, a node
+// spans about four cache lines.
+inline constexpr std::size_t UnrolledNodeBytes = 256U;
+
+template <typename T>
+inline constexpr std::size_t UnrolledNodeCapacity = std::max<std::size_t>(
+    1U, (UnrolledNodeBytes - 2U * sizeof(void *)) / sizeof(T));
+
+template <typename T, std::size_t Capacity> struct UnrolledListNode {
+  UnrolledListNode *next{nullptr};
+  std::size_t count{0U};
+  alignas(T) unsigned char storage[Capacity * sizeof(T)];
+
+  T *data() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+};
+
+template <typename T, std::size_t Capacity>
+class UnrolledListIterator
+    : public ForwardIteratorFacade<UnrolledListIterator<T, Capacity>, T> {
+private:
+  UnrolledListNode<T, Capacity> *node{nullptr};
+  std::size_t index{0U};
+
+public:
+  UnrolledListIterator(UnrolledListNode<T, Capacity> *node = nullptr)
+      : node{node} {}
+
+  T &dereference() const { return node->data()[index]; }
+  void increment() {
+    if (++index == node->count) {
+      node = node->next;
+      index = 0U;
+    }
+  }
+  bool equals(const UnrolledListIterator &other) const {
+    return node == other.node && index == other.index;
+  }
+};
+
+template <typename T, typename Allocator = PoolAllocator<T>,
+          std::size_t Capacity = UnrolledNodeCapacity<T>>
+class UnrolledLinkedList {
+private:
+  using Node = UnrolledListNode<T, Capacity>;
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+public:
+  using value_type = T;
+  using iterator = UnrolledListIterator<T, Capacity>;
+  static constexpr std::size_t node_capacity = Capacity;
+
+  UnrolledLinkedList() = default;
+  explicit UnrolledLinkedList(const Allocator &allocator)
+      : allocator{allocator} {}
+
+  UnrolledLinkedList(const UnrolledLinkedList &other)
+      : allocator{NodeTraits::select_on_container_copy_construction(
+            other.allocator)} {
+    for (auto *node = other.head; node != nullptr; node = node->next) {
+      for (std::size_t i = 0U; i < node->count; ++i)
+        push_back(node->data()[i]);
+    }
+  }
+  UnrolledLinkedList(UnrolledLinkedList &&other) noexcept
+      : allocator{other.allocator}, head{std::exchange(other.head, nullptr)},
+        tail{std::exchange(other.tail, nullptr)},
+        count{std::exchange(other.count, 0U)} {}
+  // Copy-and-swap: other is copied or moved, so assignment takes over its
+  // nodes together with the allocator they came from.
+  UnrolledLinkedList &operator=(UnrolledLinkedList other) noexcept {
+    swap(*this, other);
+    return *this;
+  }
+  friend void swap(UnrolledLinkedList &lhs, UnrolledLinkedList &rhs) noexcept {
+    using std::swap;
+    swap(lhs.allocator, rhs.allocator);
+    swap(lhs.head, rhs.head);
+    swap(lhs.tail, rhs.tail);
+    swap(lhs.count, rhs.count);
+  }
+
+  ~UnrolledLinkedList() { clear(); }
+
+  iterator begin() noexcept { return iterator{head}; }
+  iterator end() noexcept { return iterator{}; }
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0U; }
+  T &front() noexcept { return head->data()[0]; }
+
+  // Appends to the last node and only allocates a new one if it is full.
+  // A new node is only linked once the element in it has been constructed, so
+  // the list never holds an empty node.
+  template <typename... Args> T &emplace_back(Args &&...args) {
+    if (tail != nullptr && tail->count < Capacity) {
+      auto *element = ::new (static_cast<void *>(tail->data() + tail->count))
+          T(std::forward<Args>(args)...);
+      ++tail->count;
+      ++count;
+      return *element;
+    }
+    auto *node = create();
+    try {
+      ::new (static_cast<void *>(node->data())) T(std::forward<Args>(args)...);
+    } catch (...) {
+      destroy(node);
+      throw;
+    }
+    node->count = 1U;
+    (tail == nullptr ? head : tail->next) = node;
+    tail = node;
+    ++count;
+    return node->data()[0];
+  }
+  void push_back(const T &value) { emplace_back(value); }
+
+  // Prepends to the first node by shifting its elements back, or to a new
+  // first node if it is full.
+  template <typename... Args> T &emplace_front(Args &&...args) {
+    auto value = T(std::forward<Args>(args)...);
+    if (head == nullptr || head->count == Capacity) {
+      auto *node = create();
+      node->next = head;
+      head = node;
+      if (tail == nullptr)
+        tail = node;
+    }
+    auto *elements = head->data();
+    if (head->count > 0U) {
+      ::new (static_cast<void *>(elements + head->count))
+          T(std::move_if_noexcept(elements[head->count - 1U]));
+      std::move_backward(elements, elements + head->count - 1U,
+                         elements + head->count);
+      elements[0] = std::move(value);
+    } else {
+      ::new (static_cast<void *>(elements)) T(std::move(value));
+    }
+    ++head->count;
+    ++count;
+    return elements[0];
+  }
+  void push_front(const T &value) { emplace_front(value); }
+
+  void pop_front() noexcept {
+    auto *elements = head->data();
+    std::move(elements + 1, elements + head->count, elements);
+    std::destroy_at(elements + head->count - 1U);
+    --count;
+    if (--head->count == 0U) {
+      auto *node = std::exchange(head, head->next);
+      if (head == nullptr)
+        tail = nullptr;
+      destroy(node);
+    }
+  }
+
+  void clear() noexcept {
+    while (head != nullptr) {
+      std::destroy_n(head->data(), head->count);
+      destroy(std::exchange(head, head->next));
+    }
+    tail = nullptr;
+    count = 0U;
+  }
+
+private:
+  Node *create() {
+    auto *node = NodeTraits::allocate(allocator, 1U);
+    return ::new (static_cast<void *>(node)) Node;
+  }
+
+  void destroy(Node *node) noexcept {
+    node->~Node();
+    NodeTraits::deallocate(allocator, node, 1U);
+  }
+
+  NodeAllocator allocator{};
+  Node *head{nullptr};
+  Node *tail{nullptr};
+  std::size_t count{0U};
+};
+
 // Mixins
 
 // Customize behavior of a type without inheriting from it by inverting the
@@ -1,5 +1,80 @@
 #include "chapter22_bridging_static_and_dynamic_polymorphism.hpp"
+#include <array>
+#include <cassert>
+#include <string>
+#include <tuple>
+#include <vector>
+
+inline int square(int i) { return i * i; }
 
 int main() {
-return 0;
+  // Function pointers and small closures are stored inline.
+  auto fp = FunctionPtr<int(int)>{&square};
+  assert(fp(3) == 9);
+  const auto offset = 4;
+  auto lambda = FunctionPtr<int(int)>{[offset](int i) { return i + offset; }};
+  assert(lambda(3) == 7);
+
+  // Large closures fall back to the heap.
+  const auto table = std::array<int, 16U>{0, 1, 2, 3, 4, 5, 6, 7,
+                                          8, 9, 10, 11, 12, 13, 14, 15};
+  auto large = FunctionPtr<int(int)>{[table](int i) { return table[i]; }};
+  assert(large(5) == 5);
+
+  // Copies and moves of both inline and heap bridges.
+  auto lambda_copy = FunctionPtr<int(int)>{lambda};
+  auto large_copy = FunctionPtr<int(int)>{large};
+  auto lambda_moved = FunctionPtr<int(int)>{std::move(lambda_copy)};
+  assert(lambda_moved(1) == 5 && large_copy(2) == 2);
+  assert(!lambda_copy);
+
+  swap(fp, large);
+  assert(fp(7) == 7 && large(7) == 49);
+  large_copy = static_cast<const FunctionPtr<int(int)> &>(lambda_moved);
+  assert(large_copy(1) == 5 && lambda_moved(1) == 5);
+
+  // Same interface with a manual dispatch table instead of virtual functions.
+  using TableFunctionPtr = FunctionPtr<int(int), TableDispatch>;
+  auto table_lambda = TableFunctionPtr{[offset](int i) { return i + offset; }};
+  auto table_large = TableFunctionPtr{[table](int i) { return table[i]; }};
+  auto table_copy = TableFunctionPtr{table_large};
+  auto table_moved = TableFunctionPtr{std::move(table_lambda)};
+  assert(table_moved(3) == 7 && table_copy(9) == 9 && !table_lambda);
+  swap(table_moved, table_copy);
+  assert(table_moved(9) == 9 && table_copy(3) == 7);
+
+  // Vectors relocate FunctionPtrs by moving them since moves are noexcept.
+  static_assert(std::is_nothrow_move_constructible_v<FunctionPtr<int(int)>>);
+  auto callbacks = std::vector<FunctionPtr<int(int)>>{};
+  for (auto i = 0; i < 16; ++i)
+    callbacks.emplace_back([i](int j) { return i + j; });
+  assert(callbacks[15](1) == 16);
+
+  // Move-only callables bind to UniqueFunctionPtr.
+  auto owned = std::make_unique<int>(42);
+  auto unique = UniqueFunctionPtr<int()>{
+      [owned = std::move(owned)]() { return *owned; }};
+  auto unique_table = UniqueFunctionPtr<int(), TableDispatch>{
+      [owned = std::make_unique<int>(7)]() { return *owned; }};
+  auto unique_moved = std::move(unique);
+  assert(unique_moved() == 42 && unique_table() == 7 && !unique);
+
+  // Any holds small values inline and larger ones on the heap.
+  auto any_int = Any{42};
+  auto any_string = Any{std::string(64U, 'x')};
+  assert(any_int.get_value<int>() == 42);
+  assert(any_int.get_if<long>() == nullptr);
+  auto any_copy = any_string;
+  auto any_moved = std::move(any_int);
+  assert(any_copy.get_value<std::string>().size() == 64U);
+  assert(any_moved.get_value<int>() == 42 && !any_int.has_value());
+  swap(any_moved, any_copy);
+  assert(any_copy.get_value<int>() == 42);
+  try {
+    std::ignore = any_copy.get_value<std::string>();
+    assert(false);
+  } catch (const BadTypeException &) {
+  }
+
+  return 0;
 }
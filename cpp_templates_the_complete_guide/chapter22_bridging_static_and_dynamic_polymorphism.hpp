@@ -1,9 +1,13 @@
 #ifndef CPP_TEMPLATES_CHAPTER22_BRIDGING_STATIC_AND_DYNAMIC_POLYMORPHISM
 #define CPP_TEMPLATES_CHAPTER22_BRIDGING_STATIC_AND_DYNAMIC_POLYMORPHISM
 
+#include <cstddef>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <new>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 // In this chapter, we develop our own function wrapper (like std::function)
@@ -14,6 +18,11 @@ template <typename R, typename... Args> class FunctorBridge {
 public:
   virtual ~FunctorBridge() = default;
   virtual FunctorBridge *clone() const = 0;
+  // Copy- or move-construct the bridge into the inline storage of another
+  // FunctionPtr. These are only called on bridges that live in inline storage
+  // themselves, so the target storage is known to be large enough.
+  virtual FunctorBridge *clone_into(void *storage) const = 0;
+  virtual FunctorBridge *move_into(void *storage) noexcept = 0;
   // Making this const protects against invoking non-const operator() overloads.
   virtual R invoke(Args... args) const = 0;
 };
@@ -35,55 +44,329 @@ public:
   template <typename FunctorType>
   SpecificFunctorBridge(FunctorType &&f)
       : functor{std::forward<FunctorType>(f)} {}
+  // Cloning is only reachable by copying a FunctionPtr which requires Functor
+  // to be copy-constructible. Move-only functors bound to a UniqueFunctionPtr
+  // still need the overrides to exist, so the else branches are never taken.
   SpecificFunctorBridge *clone() const override {
-    return new SpecificFunctorBridge(functor);
+    if constexpr (std::is_copy_constructible_v<Functor>)
+      return new SpecificFunctorBridge(functor);
+    else
+      std::terminate();
+  }
+  SpecificFunctorBridge *clone_into(void *storage) const override {
+    if constexpr (std::is_copy_constructible_v<Functor>)
+      return ::new (storage) SpecificFunctorBridge(functor);
+    else
+      std::terminate();
+  }
+  SpecificFunctorBridge *move_into(void *storage) noexcept override {
+    // Bridges are only stored inline if their functor is nothrow
+    // move-constructible, so the else branch is never taken.
+    if constexpr (std::is_nothrow_move_constructible_v<Functor>)
+      return ::new (storage) SpecificFunctorBridge(std::move(functor));
+    else
+      std::terminate();
   }
   R invoke(Args... args) const override {
     return functor(std::forward<Args>(args)...);
   }
 };
 
+// Small-buffer optimization (SBO)
+// Allocating every bridge on the heap is wasteful as most callables are small:
+// function pointers, captureless lambdas or lambdas capturing a few references.
+// The FunctionPtr therefore reserves BufferSize bytes of suitably aligned
+// storage in the object itself and constructs the bridge in there whenever it
+// fits. Only bridges that are too large, over-aligned or whose functor may
+// throw on move fall back to the heap. The latter restriction allows
+// FunctionPtr to move inline bridges between buffers without risking an
+// exception halfway.
+
+// Default inline storage holds the vptr of the bridge plus three pointers worth
+// of captured state.
+inline constexpr std::size_t FunctionPtrBufferSize = 4U * sizeof(void *);
+inline constexpr std::size_t FunctionPtrBufferAlign = alignof(std::max_align_t);
+
+// Dispatch policies
+// How the type-erased functor is stored and invoked is factored out into a
+// policy class. Its member class template Bridge owns the (possibly inline)
+// functor and exposes construction, copy, move, invoke and empty.
+
+// Dynamic dispatch through the virtual FunctorBridge interface from above.
+struct VirtualDispatch {
+  template <std::size_t BufferSize, std::size_t BufferAlign, typename R,
+            typename... Args>
+  class Bridge {
+  private:
+    using Storage = std::aligned_storage_t<BufferSize, BufferAlign>;
+
+    // Points into storage if the bridge is stored inline and to the heap
+    // otherwise.
+    FunctorBridge<R, Args...> *bridge{nullptr};
+    Storage storage;
+
+    // Decides at compile-time whether the bridge for Functor lives inline.
+    template <typename Functor>
+    static constexpr bool fits_inline =
+        sizeof(SpecificFunctorBridge<Functor, R, Args...>) <= BufferSize &&
+        alignof(SpecificFunctorBridge<Functor, R, Args...>) <= BufferAlign &&
+        std::is_nothrow_move_constructible_v<Functor>;
+
+    bool is_local() const noexcept {
+      const auto *address = reinterpret_cast<const unsigned char *>(bridge);
+      const auto *begin = reinterpret_cast<const unsigned char *>(&storage);
+      return std::less_equal<>{}(begin, address) &&
+             std::less<>{}(address, begin + sizeof(Storage));
+    }
+
+    void steal(Bridge &other) noexcept {
+      // Inline bridges need to be moved into our own storage while heap
+      // bridges can be stolen from other by copying the pointer.
+      if (other.is_local()) {
+        bridge = other.bridge->move_into(&storage);
+        other.reset();
+      } else {
+        bridge = other.bridge;
+        other.bridge = nullptr;
+      }
+    }
+
+  public:
+    Bridge() = default;
+    template <typename Functor, typename FunctionType>
+    Bridge(std::in_place_type_t<Functor>, FunctionType &&f) {
+      // The actual function type is only known to the specialization of
+      // SpecificFunctorBridge. After the new object of specialized type is
+      // created on the heap (or in the inline storage), the pointer-to-derived
+      // converts to pointer-to-base (because bridge is of abstract base class
+      // type). When the function returns, the function type is therefore lost.
+      // This technique of bridging between static and dynamic polymorphism is
+      // therefore called type erasure.
+      using Specific = SpecificFunctorBridge<Functor, R, Args...>;
+      if constexpr (fits_inline<Functor>)
+        bridge = ::new (&storage) Specific(std::forward<FunctionType>(f));
+      else
+        bridge = new Specific(std::forward<FunctionType>(f));
+    }
+    Bridge(const Bridge &other) {
+      if (other.is_local())
+        bridge = other.bridge->clone_into(&storage);
+      else if (other.bridge)
+        bridge = other.bridge->clone();
+    }
+    Bridge(Bridge &&other) noexcept { steal(other); }
+    Bridge &operator=(Bridge &&other) noexcept {
+      if (this != &other) {
+        reset();
+        steal(other);
+      }
+      return *this;
+    }
+    ~Bridge() { reset(); }
+
+    void reset() noexcept {
+      if (is_local())
+        bridge->~FunctorBridge();
+      else
+        delete bridge;
+      bridge = nullptr;
+    }
+    bool empty() const noexcept { return bridge == nullptr; }
+    R invoke(Args... args) const {
+      // Loads the vptr from the bridge, then the function pointer from the
+      // vtable before the actual call.
+      return bridge->invoke(std::forward<Args>(args)...);
+    }
+  };
+};
+
+// Manual dispatch table
+// Instead of letting the compiler generate a vtable that is reached through a
+// vptr stored in the type-erased object, we build the table of function
+// pointers ourselves: one static instance per functor type. The FunctionPtr
+// stores a pointer to that table next to the storage that holds the functor
+// itself (or a pointer to it if it lives on the heap). Invocation then loads
+// the function pointer from the table and calls it with the address of the
+// storage, saving the additional pointer chase to reach the vptr of a bridge.
+template <typename R, typename... Args> struct FunctorTable {
+  R (*invoke)(const void *storage, Args... args);
+  void (*clone)(const void *source, void *target);
+  void (*move)(void *source, void *target) noexcept;
+  void (*destroy)(void *storage) noexcept;
+};
+
+// Manages a value of type T in type-erased storage. The value is either stored
+// inline in the storage (Local) or on the heap with only a pointer to it kept
+// in the storage. Shared by all hand-rolled tables in this chapter.
+template <typename T, bool Local> struct ErasedStorage {
+  static const T *get(const void *storage) noexcept {
+    if constexpr (Local)
+      return std::launder(static_cast<const T *>(storage));
+    else
+      return *static_cast<T *const *>(storage);
+  }
+  static T *get(void *storage) noexcept {
+    return const_cast<T *>(get(static_cast<const void *>(storage)));
+  }
+
+  template <typename... CtorArgs>
+  static void construct(void *storage, CtorArgs &&...args) {
+    if constexpr (Local)
+      ::new (storage) T(std::forward<CtorArgs>(args)...);
+    else
+      ::new (storage) T *(new T(std::forward<CtorArgs>(args)...));
+  }
+  static void clone(const void *source, void *target) {
+    construct(target, *get(source));
+  }
+  static void move(void *source, void *target) noexcept {
+    if constexpr (Local) {
+      ::new (target) T(std::move(*get(source)));
+      get(source)->~T();
+    } else {
+      ::new (target) T *(get(source));
+    }
+  }
+  static void destroy(void *storage) noexcept {
+    if constexpr (Local)
+      get(storage)->~T();
+    else
+      delete get(storage);
+  }
+};
+
+// Implements the table for Functor on top of its erased storage.
+template <typename Functor, bool Local, typename R, typename... Args>
+struct SpecificFunctorTable : ErasedStorage<Functor, Local> {
+  using Base = ErasedStorage<Functor, Local>;
+  using Base::clone;
+  using Base::destroy;
+  using Base::get;
+  using Base::move;
+
+  static R invoke(const void *storage, Args... args) {
+    // Only const operator() overloads are invoked like with FunctorBridge.
+    return (*get(storage))(std::forward<Args>(args)...);
+  }
+
+  // Move-only functors get an empty clone slot. Taking the address of clone
+  // would instantiate its body and fail to compile for them.
+  static constexpr auto clone_or_null() noexcept {
+    if constexpr (std::is_copy_constructible_v<Functor>)
+      return &clone;
+    else
+      return decltype(&clone){nullptr};
+  }
+
+  static constexpr FunctorTable<R, Args...> table{&invoke, clone_or_null(),
+                                                  &move, &destroy};
+};
+
+struct TableDispatch {
+  template <std::size_t BufferSize, std::size_t BufferAlign, typename R,
+            typename... Args>
+  class Bridge {
+  private:
+    static_assert(BufferSize >= sizeof(void *) &&
+                      BufferAlign >= alignof(void *),
+                  "Storage must at least hold a pointer to a heap functor");
+    using Storage = std::aligned_storage_t<BufferSize, BufferAlign>;
+    using Table = FunctorTable<R, Args...>;
+
+    // Without a vptr in the storage, the functor itself has to fit.
+    template <typename Functor>
+    static constexpr bool fits_inline =
+        sizeof(Functor) <= BufferSize && alignof(Functor) <= BufferAlign &&
+        std::is_nothrow_move_constructible_v<Functor>;
+
+    const Table *table{nullptr};
+    Storage storage;
+
+    void steal(Bridge &other) noexcept {
+      if (other.table) {
+        other.table->move(&other.storage, &storage);
+        table = std::exchange(other.table, nullptr);
+      }
+    }
+
+  public:
+    Bridge() = default;
+    template <typename Functor, typename FunctionType>
+    Bridge(std::in_place_type_t<Functor>, FunctionType &&f) {
+      constexpr auto local = fits_inline<Functor>;
+      ErasedStorage<Functor, local>::construct(&storage,
+                                               std::forward<FunctionType>(f));
+      table = &SpecificFunctorTable<Functor, local, R, Args...>::table;
+    }
+    Bridge(const Bridge &other) {
+      if (other.table) {
+        other.table->clone(&other.storage, &storage);
+        table = other.table;
+      }
+    }
+    Bridge(Bridge &&other) noexcept { steal(other); }
+    Bridge &operator=(Bridge &&other) noexcept {
+      if (this != &other) {
+        reset();
+        steal(other);
+      }
+      return *this;
+    }
+    ~Bridge() { reset(); }
+
+    void reset() noexcept {
+      if (table)
+        std::exchange(table, nullptr)->destroy(&storage);
+    }
+    bool empty() const noexcept { return table == nullptr; }
+    R invoke(Args... args) const {
+      return table->invoke(&storage, std::forward<Args>(args)...);
+    }
+  };
+};
+
 // Primary template
-template <typename Signature> class FunctionPtr {};
+// The dispatch policy comes first as it is the parameter most likely to be
+// replaced by client code.
+template <typename Signature, typename Dispatch = VirtualDispatch,
+          std::size_t BufferSize = FunctionPtrBufferSize,
+          std::size_t BufferAlign = FunctionPtrBufferAlign>
+class FunctionPtr {};
 
 // Partial specialization
-template <typename R, typename... Args> class FunctionPtr<R(Args...)> {
+template <typename R, typename... Args, typename Dispatch,
+          std::size_t BufferSize, std::size_t BufferAlign>
+class FunctionPtr<R(Args...), Dispatch, BufferSize, BufferAlign> {
 private:
-  FunctorBridge<R, Args...> *bridge{nullptr};
+  using Bridge =
+      typename Dispatch::template Bridge<BufferSize, BufferAlign, R, Args...>;
+  Bridge bridge;
 
 public:
   // Constructors
   FunctionPtr() = default;
-  FunctionPtr(const FunctionPtr &other) { bridge = other.bridge->clone(); };
+  FunctionPtr(const FunctionPtr &other) : bridge{other.bridge} {};
   FunctionPtr(FunctionPtr &other)
       : FunctionPtr{static_cast<const FunctionPtr &>(other)} {}
-  FunctionPtr(FunctionPtr &&other) : bridge{other.bridge} {
-    other.bridge = nullptr;
-  }
+  // Moves never allocate or throw. Containers like std::vector rely on the
+  // noexcept specification to move instead of copy when they relocate.
+  FunctionPtr(FunctionPtr &&other) noexcept
+      : bridge{std::move(other.bridge)} {}
   template <typename FunctionType>
-  FunctionPtr(FunctionType &&f) : bridge{nullptr} {
-
-    // The actual function type is only known to the specialization of
-    // SpecificFunctorBridge. After the new object of specialized type is
-    // created on the heap, the pointer-to-derived converts to pointer-to-base
-    // (because bridge is of abstract base class type). When the function
-    // returns, the function type is therefore lost.
-    // This technique of bridging between static and dynamic polymorphism is
-    // therefore called type erasure.
-    using Bridge =
-        SpecificFunctorBridge<std::decay_t<FunctionType>, R, Args...>;
-    bridge = new Bridge(std::forward<FunctionType>(f));
+  FunctionPtr(FunctionType &&f)
+      : bridge{std::in_place_type<std::decay_t<FunctionType>>,
+               std::forward<FunctionType>(f)} {
+    static_assert(std::is_copy_constructible_v<std::decay_t<FunctionType>>,
+                  "Use UniqueFunctionPtr for move-only functors");
   }
+  // Assignment operators
   FunctionPtr &operator=(const FunctionPtr &other) {
     auto tmp{other};
-    swap(*this, other);
+    swap(*this, tmp);
     return *this;
   }
-  // Assignment operators
-  FunctionPtr &operator=(FunctionPtr &&other) {
-    delete bridge;
-    bridge = other.bridge;
-    other.bridge = nullptr;
+  FunctionPtr &operator=(FunctionPtr &&other) noexcept {
+    bridge = std::move(other.bridge);
     return *this;
   }
   template <typename FunctionType> FunctionPtr &operator=(FunctionType &&f) {
@@ -91,18 +374,74 @@ public:
     swap(*this, tmp);
     return *this;
   }
-  // Destructor
-  ~FunctionPtr() { delete bridge; }
 
   // Helpers
-  friend void swap(FunctionPtr &lhs, FunctionPtr &rhs) {
+  friend void swap(FunctionPtr &lhs, FunctionPtr &rhs) noexcept {
+    std::swap(lhs.bridge, rhs.bridge);
+  }
+  explicit operator bool() const { return !bridge.empty(); }
+
+  // Invocation
+  R operator()(Args... args) const {
+    return bridge.invoke(std::forward<Args>(args)...);
+  }
+};
+
+// Move-only sibling of FunctionPtr that also binds to callables which cannot be
+// copied, e.g. lambdas capturing a std::unique_ptr. Since the bridge is never
+// cloned, the clone operations of the dispatch policies are never reached.
+template <typename Signature, typename Dispatch = VirtualDispatch,
+          std::size_t BufferSize = FunctionPtrBufferSize,
+          std::size_t BufferAlign = FunctionPtrBufferAlign>
+class UniqueFunctionPtr {};
+
+template <typename R, typename... Args, typename Dispatch,
+          std::size_t BufferSize, std::size_t BufferAlign>
+class UniqueFunctionPtr<R(Args...), Dispatch, BufferSize, BufferAlign> {
+private:
+  using Bridge =
+      typename Dispatch::template Bridge<BufferSize, BufferAlign, R, Args...>;
+  Bridge bridge;
+
+public:
+  // Constructors
+  UniqueFunctionPtr() = default;
+  UniqueFunctionPtr(const UniqueFunctionPtr &) = delete;
+  UniqueFunctionPtr(UniqueFunctionPtr &&other) noexcept
+      : bridge{std::move(other.bridge)} {}
+  // Unlike FunctionPtr, there is no non-const copy constructor to catch
+  // UniqueFunctionPtr lvalues. Disable the template for them instead so they
+  // do not get wrapped into another UniqueFunctionPtr.
+  template <typename FunctionType,
+            typename = std::enable_if_t<!std::is_same_v<
+                std::decay_t<FunctionType>, UniqueFunctionPtr>>>
+  UniqueFunctionPtr(FunctionType &&f)
+      : bridge{std::in_place_type<std::decay_t<FunctionType>>,
+               std::forward<FunctionType>(f)} {}
+  // Assignment operators
+  UniqueFunctionPtr &operator=(const UniqueFunctionPtr &) = delete;
+  UniqueFunctionPtr &operator=(UniqueFunctionPtr &&other) noexcept {
+    bridge = std::move(other.bridge);
+    return *this;
+  }
+  template <typename FunctionType,
+            typename = std::enable_if_t<!std::is_same_v<
+                std::decay_t<FunctionType>, UniqueFunctionPtr>>>
+  UniqueFunctionPtr &operator=(FunctionType &&f) {
+    bridge = Bridge{std::in_place_type<std::decay_t<FunctionType>>,
+                    std::forward<FunctionType>(f)};
+    return *this;
+  }
+
+  // Helpers
+  friend void swap(UniqueFunctionPtr &lhs, UniqueFunctionPtr &rhs) noexcept {
     std::swap(lhs.bridge, rhs.bridge);
   }
-  explicit operator bool() const { return bridge == nullptr; }
+  explicit operator bool() const { return !bridge.empty(); }
 
   // Invocation
   R operator()(Args... args) const {
-    return bridge->invoke(std::forward<Args>(args)...);
+    return bridge.invoke(std::forward<Args>(args)...);
   }
 };
 
@@ -110,26 +449,103 @@ public:
 
 struct BadTypeException : std::exception {};
 
+// Any reuses the manual dispatch table. It does not need invocation, only the
+// operations to copy, move and destroy the held value.
+struct AnyTable {
+  void (*clone)(const void *source, void *target);
+  void (*move)(void *source, void *target) noexcept;
+  void (*destroy)(void *storage) noexcept;
+};
+
+template <typename T, bool Local>
+struct SpecificAnyTable : ErasedStorage<T, Local> {
+  using Base = ErasedStorage<T, Local>;
+  static constexpr AnyTable table{&Base::clone, &Base::move, &Base::destroy};
+};
+
+// Values up to three pointers in size are held inline.
+inline constexpr std::size_t AnyBufferSize = 3U * sizeof(void *);
+
 class Any {
 private:
-  struct HolderBase {
-    virtual ~HolderBase() = default;
-  };
+  using Storage =
+      std::aligned_storage_t<AnyBufferSize, alignof(std::max_align_t)>;
 
-  template <typename T> struct Holder : public HolderBase {
-    Holder(const T &object) : object{object} {}
-    Holder(T &&object) : object{std::move(object)} {}
-    T object;
-  };
-  HolderBase *held{nullptr};
+  template <typename T>
+  static constexpr bool fits_inline =
+      sizeof(T) <= sizeof(Storage) && alignof(T) <= alignof(Storage) &&
+      std::is_nothrow_move_constructible_v<T>;
+
+  // There is exactly one static table per held type. Its address therefore
+  // doubles as a type tag that replaces dynamic_cast (and typeid) by a single
+  // pointer comparison, which also works when compiling with -fno-rtti.
+  // Note that this relies on the table not being duplicated across shared
+  // library boundaries, just like typeid comparisons do.
+  template <typename T> static constexpr const AnyTable *tag() noexcept {
+    return &SpecificAnyTable<T, fits_inline<T>>::table;
+  }
+
+  const AnyTable *table{nullptr};
+  Storage storage;
+
+  void steal(Any &other) noexcept {
+    if (other.table) {
+      other.table->move(&other.storage, &storage);
+      table = std::exchange(other.table, nullptr);
+    }
+  }
 
 public:
-  template <typename T>
-  Any(T &&object) : held{std::make_unique<T>(std::forward<T>(object))} {}
+  Any() = default;
+  // Disabled for Any itself so that copies of non-const Any lvalues do not end
+  // up wrapping an Any into an Any.
+  template <typename T,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Any>>>
+  Any(T &&object) {
+    using ValueT = std::decay_t<T>;
+    ErasedStorage<ValueT, fits_inline<ValueT>>::construct(
+        &storage, std::forward<T>(object));
+    table = tag<ValueT>();
+  }
+  Any(const Any &other) {
+    if (other.table) {
+      other.table->clone(&other.storage, &storage);
+      table = other.table;
+    }
+  }
+  Any(Any &&other) noexcept { steal(other); }
+  Any &operator=(const Any &other) {
+    auto tmp{other};
+    swap(*this, tmp);
+    return *this;
+  }
+  Any &operator=(Any &&other) noexcept {
+    if (this != &other) {
+      reset();
+      steal(other);
+    }
+    return *this;
+  }
+  ~Any() { reset(); }
+
+  friend void swap(Any &lhs, Any &rhs) noexcept {
+    auto tmp{std::move(lhs)};
+    lhs = std::move(rhs);
+    rhs = std::move(tmp);
+  }
 
-  bool has_value() const { return !(held == nullptr); }
+  void reset() noexcept {
+    if (table)
+      std::exchange(table, nullptr)->destroy(&storage);
+  }
+  bool has_value() const { return !(table == nullptr); }
+  template <typename T> const T *get_if() const noexcept {
+    if (table == tag<T>())
+      return ErasedStorage<T, fits_inline<T>>::get(&storage);
+    return nullptr;
+  }
   template <typename T> const T &get_value() const {
-    if (const auto specific_held = dynamic_cast<const Holder<T> *>(held))
+    if (const auto specific_held = get_if<T>())
       return *specific_held;
     else
       throw BadTypeException{};
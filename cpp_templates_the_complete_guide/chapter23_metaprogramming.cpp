@@ -1,3 +1,64 @@
 #include "chapter23_metaprogramming.hpp"
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
 
-int main() { return 0; }
+using Seconds = Ratio<1>;
+using Milliseconds = Ratio<1, 1000>;
+using Microseconds = Ratio<1, 1000000>;
+using Minutes = Ratio<60>;
+
+int main() {
+  // Ratios are reduced.
+  static_assert(std::is_same_v<Ratio<2, 2000>::Type, Milliseconds>);
+  static_assert(
+      std::is_same_v<RatioAdd<Ratio<1, 6>, Ratio<1, 3>>, Ratio<1, 2>>);
+  static_assert(
+      std::is_same_v<RatioDivide<Seconds, Milliseconds>, Ratio<1000>>);
+  static_assert(std::is_same_v<CommonUnit<Milliseconds, Microseconds, Minutes>,
+                               Microseconds>);
+  static_assert(std::is_same_v<CommonUnit<Ratio<1, 3>, Ratio<1, 2>>,
+                               Ratio<1, 6>>);
+  // Multiplying the denominators would long have overflowed here.
+  static_assert(
+      std::is_same_v<CommonUnit<Ratio<1, 10000000000U>, Ratio<1, 100000000U>,
+                                Ratio<1, 1000000000000U>>,
+                     Ratio<1, 1000000000000U>>);
+
+  // A chain of additions is one sum in the common unit.
+  {
+    constexpr auto sum = Duration<int, Seconds>{1} +
+                         Duration<int, Milliseconds>{500} +
+                         Duration<int, Microseconds>{250} +
+                         Duration<int, Minutes>{1};
+    static_assert(std::is_same_v<decltype(sum)::UnitType, Microseconds>);
+    static_assert(sum.value() == 61500250);
+    static_assert(duration_cast<Milliseconds>(sum).value() == 61500);
+
+    constexpr Duration<int, Microseconds> total = sum;
+    static_assert(total.value() == 61500250);
+    constexpr auto both = (Duration<int>{1} + Duration<int>{2}) +
+                          (Duration<long, Milliseconds>{3} +
+                           Duration<int, Milliseconds>{4});
+    static_assert(std::is_same_v<decltype(both)::ValueType, long>);
+    static_assert(both.value() == 3007);
+  }
+
+  // Batch conversion between units.
+  {
+    auto samples = std::vector<Duration<std::int64_t, Microseconds>>{};
+    for (std::int64_t i = 0; i < 1000; ++i)
+      samples.emplace_back(i * 1001);
+    auto converted = std::vector<Duration<std::int64_t, Milliseconds>>(
+        samples.size());
+    const auto *end = convert_durations(samples.data(),
+                                        samples.data() + samples.size(),
+                                        converted.data());
+    assert(end == converted.data() + converted.size());
+    for (std::size_t i = 0U; i < samples.size(); ++i)
+      assert(converted[i].value() == samples[i].value() / 1000);
+  }
+
+  return 0;
+}
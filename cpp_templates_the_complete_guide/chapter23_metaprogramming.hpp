@@ -1,7 +1,13 @@
 #ifndef CPP_TEMPLATES_CHAPTER23_METAPROGRAMMING
 #define CPP_TEMPLATES_CHAPTER23_METAPROGRAMMING
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 
 // A simple type metafunction that removes all extents of a raw array
 // expression.
@@ -29,22 +35,96 @@ using RemoveAllExtents = typename RemoveAllExtentsT<T>::Type;
 
 // Hybrid metaprogramming for unit types in the style of std::chrono..
 
-template <unsigned N, unsigned D = 1> struct Ratio {
-  static constexpr unsigned num = N;
-  static constexpr unsigned den = D;
+// Numerators and denominators are computed at compile time, so every product
+// is checked for overflow. A constant expression that throws does not compile.
+using RatioValue = std::uintmax_t;
+
+constexpr RatioValue ratio_multiply(RatioValue lhs, RatioValue rhs) {
+  if (rhs != 0U && lhs > std::numeric_limits<RatioValue>::max() / rhs)
+    throw std::overflow_error{"Ratio overflows"};
+  return lhs * rhs;
+}
+
+constexpr RatioValue ratio_add(RatioValue lhs, RatioValue rhs) {
+  if (lhs > std::numeric_limits<RatioValue>::max() - rhs)
+    throw std::overflow_error{"Ratio overflows"};
+  return lhs + rhs;
+}
+
+constexpr RatioValue ratio_lcm(RatioValue lhs, RatioValue rhs) {
+  return ratio_multiply(lhs / std::gcd(lhs, rhs), rhs);
+}
+
+// Ratios are reduced by their greatest common divisor, so that equal ratios
+// have the same Type and later products stay as small as possible.
+template <RatioValue N, RatioValue D = 1> struct Ratio {
+  static_assert(D != 0U, "Denominator must not be zero");
+  static constexpr RatioValue num = N / std::gcd(N, D);
+  static constexpr RatioValue den = D / std::gcd(N, D);
   using Type = Ratio<num, den>;
 };
 
-// Adds two ratios, i.e. den1/num1 + den2/num2.
+// Adds two ratios, i.e. num1/den1 + num2/den2, over the least common multiple
+// of both denominators.
 template <typename R1, typename R2> class RatioAddImpl {
 private:
-  static constexpr unsigned den = R1::den * R2::den;
-  static constexpr unsigned num = R1::num * R2::den + R2::num * R1::den;
+  static constexpr RatioValue den = ratio_lcm(R1::den, R2::den);
+  static constexpr RatioValue num =
+      ratio_add(ratio_multiply(R1::num, den / R1::den),
+                ratio_multiply(R2::num, den / R2::den));
 
 public:
-  using Type = Ratio<num, den>;
+  using Type = typename Ratio<num, den>::Type;
 };
-template <typename R1, typename R2> using RatioAdd = RatioAddImpl<R1, R2>;
+template <typename R1, typename R2>
+using RatioAdd = typename RatioAddImpl<R1, R2>::Type;
+
+// Divides two ratios, i.e. (num1/den1) / (num2/den2). Both cross products are
+// reduced before multiplying.
+template <typename R1, typename R2> class RatioDivideImpl {
+private:
+  static constexpr RatioValue gcd_num = std::gcd(R1::num, R2::num);
+  static constexpr RatioValue gcd_den = std::gcd(R1::den, R2::den);
+
+public:
+  using Type = typename Ratio<
+      ratio_multiply(R1::num / gcd_num, R2::den / gcd_den),
+      ratio_multiply(R1::den / gcd_den, R2::num / gcd_num)>::Type;
+};
+template <typename R1, typename R2>
+using RatioDivide = typename RatioDivideImpl<R1, R2>::Type;
+
+// The largest unit that all units are integral multiples of, i.e. the greatest
+// common divisor of the numerators over the least common multiple of the
+// denominators. Unlike the product of all denominators, values converted to it
+// grow no more than necessary.
+template <typename U, typename... Us> struct CommonUnitT {
+  using Type = typename U::Type;
+};
+template <typename U1, typename U2, typename... Us>
+struct CommonUnitT<U1, U2, Us...> {
+  using Type = typename CommonUnitT<
+      Ratio<std::gcd(U1::num, U2::num), ratio_lcm(U1::den, U2::den)>,
+      Us...>::Type;
+};
+template <typename... Us>
+using CommonUnit = typename CommonUnitT<Us...>::Type;
+
+// Converts value from unit From to unit To. The conversion factor is a
+// compile-time constant. Conversions to a common unit have an integral factor
+// and only multiply.
+template <typename To, typename From, typename T>
+constexpr T convert_unit(T value) noexcept {
+  using Factor = RatioDivide<From, To>;
+  if constexpr (std::is_integral_v<T>)
+    static_assert(std::max(Factor::num, Factor::den) <=
+                      static_cast<RatioValue>(std::numeric_limits<T>::max()),
+                  "Conversion factor overflows the value type");
+  if constexpr (Factor::den == 1U)
+    return value * static_cast<T>(Factor::num);
+  else
+    return value * static_cast<T>(Factor::num) / static_cast<T>(Factor::den);
+}
 
 // Duration type for values of type T with unit type U.
 template <typename T, typename U = Ratio<1>> class Duration {
@@ -58,21 +138,116 @@ private:
 public:
   constexpr Duration(ValueType val = 0) noexcept : val_{val} {}
   constexpr ValueType value() const noexcept { return val_; }
+
+  // The value converted to unit To and type V, see DurationSum below.
+  template <typename To, typename V> constexpr V value_in() const noexcept {
+    return convert_unit<To, UnitType>(static_cast<V>(val_));
+  }
 };
 
-// Adds two durations with arbitrary unit types.
-template <typename T1, typename U1, typename T2, typename U2>
-constexpr auto operator+(const Duration<T1, U1> &lhs,
-                         const Duration<T2, U2> &rhs) {
-  // Resulting unit type has numerator of 1 and denominator as a result of
-  // adding both fractions.
-  using RR = Ratio<1, RatioAdd<U1, U2>::den>;
+// Converts a duration to another unit, truncating if the target unit is
+// coarser.
+template <typename ToUnit, typename T, typename U>
+constexpr Duration<T, ToUnit> duration_cast(const Duration<T, U> &d) noexcept {
+  return convert_unit<typename ToUnit::Type, typename U::Type>(d.value());
+}
+
+// Expression template for sums of durations. Adding two durations does not
+// compute anything yet but returns a DurationSum that stores both operands, so
+// a + b + c + d is a tree of DurationSums with the four durations as leaves.
+// Only value() computes the sum. It converts every leaf exactly once, straight
+// to the common unit of all leaves, and adds them up. Computing the sum
+// pairwise would instead convert the partial sums again at every addition
+// whose unit differs from the previous ones.
+template <typename L, typename R> class DurationSum {
+public:
+  using ValueType =
+      std::common_type_t<typename L::ValueType, typename R::ValueType>;
+  using UnitType = CommonUnit<typename L::UnitType, typename R::UnitType>;
+
+private:
+  L lhs_;
+  R rhs_;
 
-  // Sum of both values converted to the resulting unit type.
-  auto val = lhs.value() * RR::den / U1::den * U1::num +
-             rhs.value() * RR::den / U2::den * U2::num;
+public:
+  constexpr DurationSum(const L &lhs, const R &rhs) noexcept
+      : lhs_{lhs}, rhs_{rhs} {}
+
+  constexpr ValueType value() const noexcept {
+    return value_in<UnitType, ValueType>();
+  }
+
+  template <typename To, typename V> constexpr V value_in() const noexcept {
+    return lhs_.template value_in<To, V>() + rhs_.template value_in<To, V>();
+  }
+
+  constexpr operator Duration<ValueType, UnitType>() const noexcept {
+    return value();
+  }
+};
+
+template <typename T> struct IsDurationExprT : std::false_type {};
+template <typename T, typename U>
+struct IsDurationExprT<Duration<T, U>> : std::true_type {};
+template <typename L, typename R>
+struct IsDurationExprT<DurationSum<L, R>> : std::true_type {};
+template <typename T>
+constexpr bool IsDurationExpr = IsDurationExprT<T>::value;
+
+template <typename ToUnit, typename L, typename R>
+constexpr auto duration_cast(const DurationSum<L, R> &sum) noexcept {
+  using Sum = DurationSum<L, R>;
+  return duration_cast<ToUnit>(
+      Duration<typename Sum::ValueType, typename Sum::UnitType>{sum.value()});
+}
+
+// Adds two durations or sums of durations with arbitrary unit types.
+template <typename L, typename R,
+          typename = std::enable_if_t<IsDurationExpr<L> && IsDurationExpr<R>>>
+constexpr DurationSum<L, R> operator+(const L &lhs, const R &rhs) noexcept {
+  return {lhs, rhs};
+}
+
+// Converts the durations in [first, last) to ToUnit and writes them to out.
+// The conversion is a multiplication (and division) of every value by
+// compile-time constants. Compilers only vectorize the plain loop at -O2 if
+// they do not have to check at runtime whether the input overlaps the output
+// and the trip count is known. So blocks of elements are converted into a
+// local buffer first, whose loop has neither problem, which works as Duration
+// is laid out exactly like its value. x86 only multiplies 64-bit integers in
+// vector registers with AVX-512DQ, so these stay with the plain loop, which
+// is faster otherwise.
+inline constexpr std::size_t DurationBlockSize = 16U;
+
+template <typename T>
+constexpr bool ConvertsInBlocks = std::is_floating_point_v<T> ||
+#if defined(__AVX512DQ__) || !(defined(__x86_64__) || defined(__i386__))
+                                  std::is_integral_v<T>;
+#else
+                                  (std::is_integral_v<T> && sizeof(T) < 8U);
+#endif
 
-  return Duration<decltype(val), RR>{val};
+template <typename ToUnit, typename T, typename U>
+Duration<T, ToUnit> *convert_durations(const Duration<T, U> *first,
+                                       const Duration<T, U> *last,
+                                       Duration<T, ToUnit> *out) noexcept {
+  static_assert(sizeof(Duration<T, U>) == sizeof(T) &&
+                std::is_trivially_copyable_v<Duration<T, U>>);
+  using From = typename U::Type;
+  using To = typename ToUnit::Type;
+  if constexpr (ConvertsInBlocks<T>) {
+    for (; static_cast<std::size_t>(last - first) >= DurationBlockSize;
+         first += DurationBlockSize, out += DurationBlockSize) {
+      T block[DurationBlockSize];
+      for (std::size_t k = 0U; k < DurationBlockSize; ++k)
+        block[k] = convert_unit<To, From>(first[k].value());
+      for (std::size_t k = 0U; k < DurationBlockSize; ++k)
+        out[k] = block[k];
+    }
+  }
+  for (; first != last; ++first, ++out)
+    *out = duration_cast<ToUnit>(*first);
+  return out;
 }
 
 #endif // !CPP_TEMPLATES_CHAPTER23_METAPROGRAMMING
@@ -1,4 +1,40 @@
 #include "chapter24_typelists.hpp"
+#include <cassert>
+#include <string>
+#include <type_traits>
+
+// Messages routed by their type ID.
+struct Ping {
+  static constexpr int priority = 1;
+};
+struct Pong {
+  static constexpr int priority = 2;
+};
+struct Data {
+  static constexpr int priority = 3;
+};
+struct Ack {
+  static constexpr int priority = 4;
+};
+struct Close {
+  static constexpr int priority = 5;
+};
+using SmallProtocol = Typelist<Ping, Pong, Data>;
+using LargeProtocol = Typelist<Ping, Pong, Data, Ack, Close>;
+
+struct PriorityVisitor {
+  int calls{0};
+  template <typename Message> int operator()(TypeTag<Message>, int scale) {
+    ++calls;
+    return Message::priority * scale;
+  }
+};
+
+// Tags of the fields of an entity.
+struct Alive {};
+struct Position {};
+struct Health {};
+struct Team {};
 
 int main() {
   using SignedIntegralTypes = Typelist<short, int, long, long long>;
@@ -22,5 +58,104 @@ int main() {
   using InsertionSortedSignedIntegralTypes =
       InsertionSort<SignedIntegralTypes, SmallerThanT>;
 
+  // The pack expansion based algorithms compute the same results.
+  using LongList = Typelist<char, short, int, long long, bool, double, float,
+                            long double, char, signed char>;
+  static_assert(std::is_same_v<flat::NthElement<LongList, 3>,
+                               NthElement<LongList, 3>>);
+  static_assert(std::is_same_v<flat::NthElement<LongList, 9>, signed char>);
+  static_assert(std::is_same_v<flat::Drop<LongList, 8>,
+                               Typelist<char, signed char>>);
+  static_assert(std::is_same_v<flat::Take<LongList, 2>, Typelist<char, short>>);
+  static_assert(std::is_same_v<flat::PushBack<SignedIntegralTypes, bool>,
+                               PushBack<SignedIntegralTypes, bool>>);
+  static_assert(std::is_same_v<flat::Reverse<LongList>, Reverse<LongList>>);
+  static_assert(std::is_same_v<flat::Reverse<SignedIntegralTypes>,
+                               ReversedSignedIntegralTypes>);
+  static_assert(std::is_same_v<flat::Reverse<Typelist<>>, Typelist<>>);
+  static_assert(std::is_same_v<flat::PopBack<LongList>, PopBack<LongList>>);
+  static_assert(std::is_same_v<flat::Transform<SignedIntegralTypes, AddConstT>,
+                               ConstSignedIntegralTypes>);
+  static_assert(
+      std::is_same_v<flat::Reduce<LongList, LargerTypeT, char>, long double>);
+  static_assert(std::is_same_v<flat::Reduce<Typelist<>, LargerTypeT, char>,
+                               char>);
+  static_assert(std::is_same_v<LargestSignedIntegralType,
+                               flat::Reduce<PopFront<SignedIntegralTypes>,
+                                            LargerTypeT,
+                                            Front<SignedIntegralTypes>>>);
+  // Merge sort is stable, equally large types keep their order. Insertion sort
+  // swaps long and long long.
+  static_assert(std::is_same_v<InsertionSortedSignedIntegralTypes,
+                               Typelist<short, int, long long, long>>);
+  static_assert(
+      std::is_same_v<flat::MergeSort<SignedIntegralTypes, SmallerThanT>,
+                     Typelist<short, int, long, long long>>);
+  static_assert(
+      std::is_same_v<flat::MergeSort<LongList, SmallerThanT>,
+                     Typelist<char, bool, char, signed char, short, int, float,
+                              long long, double, long double>>);
+
+  // Dispatch with an if constexpr chain and with a function pointer table.
+  static_assert(flat::IndexOf<LargeProtocol, Ack> == 3U);
+  static_assert(flat::IndexOf<LargeProtocol, Close> == 4U);
+  auto visitor = PriorityVisitor{};
+  assert(dispatch<SmallProtocol>(0U, visitor, 10) == 10);
+  assert(dispatch<SmallProtocol>(2U, visitor, 10) == 30);
+  for (std::size_t id = 0U; id < DispatchTable<LargeProtocol>::size; ++id)
+    assert(dispatch<LargeProtocol>(id, visitor, 2) ==
+           2 * static_cast<int>(id + 1U));
+  assert(visitor.calls == 7);
+  auto name = std::string{};
+  dispatch<LargeProtocol>(4U, [&name](auto tag) {
+    name = std::is_same_v<typename decltype(tag)::Type, Close> ? "Close" : "";
+  });
+  assert(name == "Close");
+  auto threw = false;
+  try {
+    dispatch<LargeProtocol>(5U, visitor, 1);
+  } catch (const BadTypeIdException &) {
+    threw = true;
+  }
+  assert(threw && visitor.calls == 7);
+
+  // Reordering the elements removes all padding except for the tail padding.
+  struct Unordered {
+    char a;
+    double b;
+    short c;
+    int d;
+    char e;
+  };
+  using Packed = PackedTuple<char, double, short, int, char>;
+  static_assert(sizeof(Unordered) == 32U);
+  static_assert(sizeof(Packed) == 16U);
+  static_assert(sizeof(PackedTuple<char>) == 1U);
+  auto packed = Packed{'a', 2.5, short{3}, 4, 'e'};
+  assert(get<0>(packed) == 'a' && get<1>(packed) == 2.5);
+  assert(get<2>(packed) == 3 && get<3>(packed) == 4 && get<4>(packed) == 'e');
+  // The double is stored first, the second char last.
+  const auto *base = reinterpret_cast<const char *>(&packed);
+  assert(reinterpret_cast<const char *>(&get<1>(packed)) == base);
+  assert(reinterpret_cast<const char *>(&get<4>(packed)) == base + 15);
+  get<3>(packed) = 40;
+  const auto &[a, b, c, d, e] = packed;
+  assert(a == 'a' && b == 2.5 && c == 3 && d == 40 && e == 'e');
+  const auto copy = packed;
+  assert(get<3>(copy) == 40);
+  const auto empty_value = Packed{};
+  assert(get<1>(empty_value) == 0.0);
+  auto strings = PackedTuple<char, std::string>{'x', "moved"};
+  const auto moved = get<1>(std::move(strings));
+  assert(moved == "moved");
+
+  using Entity = PackedRecord<Field<Alive, bool>, Field<Position, double>,
+                              Field<Health, short>, Field<Team, char>>;
+  static_assert(sizeof(Entity) == 16U);
+  auto entity = Entity{true, 1.5, short{100}, 'r'};
+  get<Health>(entity) -= 10;
+  assert(get<Alive>(entity) && get<Position>(entity) == 1.5);
+  assert(get<Health>(entity) == 90 && get<Team>(entity) == 'r');
+
   return 0;
 }
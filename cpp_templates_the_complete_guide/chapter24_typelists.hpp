@@ -2,7 +2,11 @@
 #define CPP_TEMPLATES_CHAPTER24_TYPELISTS
 
 #include "chapter19_implementing_traits.hpp"
+#include <array>
 #include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 
 // Typelist implementation.
 
@@ -133,6 +137,7 @@ class ReverseT<List, false>
     : public PushBackT<Reverse<PopFront<List>>, Front<List>> {};
 // Base case. Identity function on an empty typelist.
 template <typename List> class ReverseT<List, true> {
+public:
   using Type = List;
 };
 
@@ -262,7 +267,469 @@ public:
 
 // SmallerThan comparison metafunction for insertion sort.
 template <typename T, typename U> class SmallerThanT {
+public:
   static constexpr bool value = (sizeof(T) < sizeof(U));
 };
 
+// Pack expansion based typelist algorithms.
+// The algorithms above recurse once per element. Every step instantiates a new
+// class template one level deeper than the previous one, so long typelists are
+// slow to compile, use a lot of memory and eventually exceed the maximum
+// template instantiation depth. The algorithms in this namespace compute the
+// same results by expanding parameter packs, which needs a constant number of
+// instantiations per result (or a logarithmic number for Reduce and
+// MergeSort).
+namespace flat {
+
+// Number of elements in the typelist.
+template <typename List> struct SizeT;
+template <typename... Elements> struct SizeT<Typelist<Elements...>> {
+  static constexpr std::size_t value = sizeof...(Elements);
+};
+
+// Get the type at index N.
+// Every element becomes a base class of a single class, tagged with its index.
+// Overload resolution then deduces the element type from the only base class
+// with index N. The class is instantiated once per list and shared by all
+// lookups into it.
+template <std::size_t I, typename T> struct IndexedT {
+  using Type = T;
+};
+template <typename List, typename Indices> struct IndexedTypelistT;
+template <typename... Elements, std::size_t... Is>
+struct IndexedTypelistT<Typelist<Elements...>, std::index_sequence<Is...>>
+    : IndexedT<Is, Elements>... {};
+template <typename List>
+using IndexedTypelist =
+    IndexedTypelistT<List, std::make_index_sequence<SizeT<List>::value>>;
+
+// Only used in unevaluated contexts, hence no definition.
+template <std::size_t I, typename T>
+IndexedT<I, T> select_indexed(const IndexedT<I, T> &);
+
+template <typename List, unsigned N>
+class NthElementT : public decltype(select_indexed<N>(
+                        std::declval<IndexedTypelist<List>>())) {};
+template <typename List, unsigned N>
+using NthElement = typename NthElementT<List, N>::Type;
+
+// Get the index of type T, the inverse of NthElement. Deduction from the base
+// classes is ambiguous and fails to compile if T occurs more than once.
+template <typename T, std::size_t I>
+std::integral_constant<std::size_t, I> select_index(const IndexedT<I, T> &);
+
+template <typename List, typename T>
+class IndexOfT
+    : public decltype(select_index<T>(std::declval<IndexedTypelist<List>>())) {
+};
+template <typename List, typename T>
+inline constexpr std::size_t IndexOf = IndexOfT<List, T>::value;
+
+// Drop the first N elements of the typelist.
+// The first N elements are matched by the N const void * parameters of drop()
+// and the remaining ones are deduced from the trailing parameter pack.
+template <typename Indices> struct DropIndices;
+template <std::size_t... Is> struct DropIndices<std::index_sequence<Is...>> {
+  template <typename... Rest>
+  static Typelist<typename Rest::Type...>
+  drop(decltype((void)Is, static_cast<const void *>(nullptr))..., Rest *...);
+};
+template <typename List, std::size_t N> class DropT;
+template <typename... Elements, std::size_t N>
+class DropT<Typelist<Elements...>, N> {
+public:
+  using Type = decltype(DropIndices<std::make_index_sequence<N>>::drop(
+      static_cast<IdentityT<Elements> *>(nullptr)...));
+};
+template <typename List, std::size_t N>
+using Drop = typename DropT<List, N>::Type;
+
+// Take the first N elements of the typelist.
+template <typename List, typename Indices> class SelectT;
+template <typename List, std::size_t... Is>
+class SelectT<List, std::index_sequence<Is...>> {
+public:
+  using Type = Typelist<NthElement<List, Is>...>;
+};
+template <typename List, std::size_t N>
+using Take = typename SelectT<List, std::make_index_sequence<N>>::Type;
+
+// Push to the back of the typelist and return the extended typelist.
+template <typename List, typename NewElement> class PushBackT;
+template <typename... Elements, typename NewElement>
+class PushBackT<Typelist<Elements...>, NewElement> {
+public:
+  using Type = Typelist<Elements..., NewElement>;
+};
+template <typename List, typename NewElement>
+using PushBack = typename PushBackT<List, NewElement>::Type;
+
+// Reverse the typelist by looking up the elements in the reversed order.
+template <typename List, typename Indices> class ReverseIndicesT;
+template <typename List, std::size_t... Is>
+class ReverseIndicesT<List, std::index_sequence<Is...>> {
+public:
+  using Type = Typelist<NthElement<List, SizeT<List>::value - 1U - Is>...>;
+};
+template <typename List>
+using Reverse = typename ReverseIndicesT<
+    List, std::make_index_sequence<SizeT<List>::value>>::Type;
+
+// Pop from the back of the typelist and return the remaining typelist.
+template <typename List> using PopBack = Take<List, SizeT<List>::value - 1U>;
+
+// Transform a typelist with a single pack expansion.
+template <typename List, template <typename T> typename MetaFcn>
+class TransformT;
+template <typename... Elements, template <typename T> typename MetaFcn>
+class TransformT<Typelist<Elements...>, MetaFcn> {
+public:
+  using Type = Typelist<typename MetaFcn<Elements>::Type...>;
+};
+template <typename List, template <typename T> typename MetaFcn>
+using Transform = typename TransformT<List, MetaFcn>::Type;
+
+// Reducing a typelist.
+// Computes F(I, F(F(T1, T2), F(T3, T4)) ... ) by splitting the list into halves
+// instead of F( ... F(F(I, T1), T2) ... Tn), so the instantiation depth only
+// grows logarithmically with the length of the list. Both are the same iff F
+// is associative (e.g. LargerTypeT), but not for metafunctions such as
+// PushFrontT that build up a result from the elements. Use the recursive
+// Reduce for those.
+template <typename List, template <typename X, typename Y> typename F,
+          std::size_t N = SizeT<List>::value>
+class TreeReduceT {
+private:
+  using Left = typename TreeReduceT<Take<List, N / 2U>, F>::Type;
+  using Right = typename TreeReduceT<Drop<List, N / 2U>, F>::Type;
+
+public:
+  using Type = typename F<Left, Right>::Type;
+};
+template <typename List, template <typename X, typename Y> typename F>
+class TreeReduceT<List, F, 1U> : public FrontT<List> {};
+
+template <typename List, template <typename X, typename Y> typename F,
+          typename I, bool = IsEmpty<List>::value>
+class ReduceT : public F<I, typename TreeReduceT<List, F>::Type> {};
+template <typename List, template <typename X, typename Y> typename F,
+          typename I>
+class ReduceT<List, F, I, true> {
+public:
+  using Type = I;
+};
+template <typename List, template <typename X, typename Y> typename F,
+          typename I>
+using Reduce = typename ReduceT<List, F, I>::Type;
+
+// Perform merge sort on a typelist.
+// MergeT merges the sorted lists Left and Right and appends the result to
+// Result. It takes the front of Right iff it is strictly smaller than the front
+// of Left, which makes the sort stable (unlike InsertionSort, which reverses
+// the order of equal elements).
+template <typename Result, typename Left, typename Right,
+          template <typename T, typename U> typename Compare>
+class MergeT;
+template <typename... Results, typename... Lefts,
+          template <typename T, typename U> typename Compare>
+class MergeT<Typelist<Results...>, Typelist<Lefts...>, Typelist<>, Compare> {
+public:
+  using Type = Typelist<Results..., Lefts...>;
+};
+template <typename... Results, typename Right, typename... Rights,
+          template <typename T, typename U> typename Compare>
+class MergeT<Typelist<Results...>, Typelist<>, Typelist<Right, Rights...>,
+             Compare> {
+public:
+  using Type = Typelist<Results..., Right, Rights...>;
+};
+template <typename... Results, typename Left, typename... Lefts,
+          typename Right, typename... Rights,
+          template <typename T, typename U> typename Compare>
+class MergeT<Typelist<Results...>, Typelist<Left, Lefts...>,
+             Typelist<Right, Rights...>, Compare>
+    : public IfThenElse<
+          Compare<Right, Left>::value,
+          MergeT<Typelist<Results..., Right>, Typelist<Left, Lefts...>,
+                 Typelist<Rights...>, Compare>,
+          MergeT<Typelist<Results..., Left>, Typelist<Lefts...>,
+                 Typelist<Right, Rights...>, Compare>> {};
+
+// Sorts both halves of the list recursively and merges them. Unlike
+// InsertionSort, which nests as deep as the list is long twice, the recursion
+// only nests as deep as the logarithm of the length plus the length of the
+// final merge.
+template <typename List, template <typename T, typename U> typename Compare,
+          std::size_t N = SizeT<List>::value>
+class MergeSortT;
+template <typename List, template <typename T, typename U> typename Compare>
+using MergeSort = typename MergeSortT<List, Compare>::Type;
+template <typename List, template <typename T, typename U> typename Compare,
+          std::size_t N>
+class MergeSortT
+    : public MergeT<Typelist<>, MergeSort<Take<List, N / 2U>, Compare>,
+                    MergeSort<Drop<List, N / 2U>, Compare>, Compare> {};
+template <typename List, template <typename T, typename U> typename Compare>
+class MergeSortT<List, Compare, 0U> {
+public:
+  using Type = List;
+};
+template <typename List, template <typename T, typename U> typename Compare>
+class MergeSortT<List, Compare, 1U> {
+public:
+  using Type = List;
+};
+
+} // namespace flat
+
+// Static dispatch over a typelist.
+// Calls visitor(TypeTag<T>{}, args...) for the type T at index type_id of the
+// typelist, e.g. to route messages by the type ID of their header without a
+// hand-written switch. Type IDs are consecutive, so the call is resolved by
+// indexing a dense, compile-time array of function pointers with one function
+// per type, followed by a single indirect call. For a few types, an if
+// constexpr chain of comparisons is cheaper than the indirect call and allows
+// inlining: it is used for typelists of up to DispatchChainThreshold types.
+// All calls of the visitor must return the same type.
+template <typename T> struct TypeTag {
+  using Type = T;
+};
+
+inline constexpr std::size_t DispatchChainThreshold = 4U;
+
+class BadTypeIdException : public std::out_of_range {
+public:
+  BadTypeIdException() : std::out_of_range{"type ID out of range"} {}
+};
+
+template <typename List> class DispatchTable;
+template <typename... Elements> class DispatchTable<Typelist<Elements...>> {
+public:
+  static constexpr std::size_t size = sizeof...(Elements);
+
+  template <typename Visitor, typename... Args>
+  static decltype(auto) dispatch(std::size_t type_id, Visitor &&visitor,
+                                 Args &&...args) {
+    static_assert(size > 0U, "cannot dispatch over an empty typelist");
+    if (type_id >= size)
+      throw BadTypeIdException{};
+    if constexpr (size <= DispatchChainThreshold) {
+      return dispatch_chain<0U>(type_id, visitor, std::forward<Args>(args)...);
+    } else {
+      using R = Result<Visitor, Args...>;
+      return table<R, Visitor, Args...>[type_id](visitor,
+                                                 std::forward<Args>(args)...);
+    }
+  }
+
+private:
+  using List = Typelist<Elements...>;
+
+  template <typename Visitor, typename... Args>
+  using Result = decltype(std::declval<Visitor &>()(
+      TypeTag<Front<List>>{}, std::declval<Args>()...));
+
+  template <typename T, typename R, typename Visitor, typename... Args>
+  static R call(Visitor &visitor, Args &&...args) {
+    static_assert(
+        std::is_same_v<decltype(visitor(TypeTag<T>{},
+                                        std::forward<Args>(args)...)),
+                       R>,
+        "all calls of the visitor must return the same type");
+    return visitor(TypeTag<T>{}, std::forward<Args>(args)...);
+  }
+
+  template <typename R, typename Visitor, typename... Args>
+  static constexpr std::array<R (*)(Visitor &, Args &&...), size> table = {
+      &call<Elements, R, Visitor, Args...>...};
+
+  template <std::size_t I, typename Visitor, typename... Args>
+  static decltype(auto) dispatch_chain(std::size_t type_id, Visitor &visitor,
+                                       Args &&...args) {
+    using R = Result<Visitor, Args...>;
+    using T = flat::NthElement<List, I>;
+    // The last type needs no comparison, type_id has already been checked.
+    if constexpr (I + 1U == size) {
+      return call<T, R, Visitor, Args...>(visitor, std::forward<Args>(args)...);
+    } else {
+      if (type_id == I)
+        return call<T, R, Visitor, Args...>(visitor,
+                                            std::forward<Args>(args)...);
+      return dispatch_chain<I + 1U>(type_id, visitor,
+                                    std::forward<Args>(args)...);
+    }
+  }
+};
+
+template <typename List, typename Visitor, typename... Args>
+decltype(auto) dispatch(std::size_t type_id, Visitor &&visitor,
+                        Args &&...args) {
+  return DispatchTable<List>::dispatch(type_id, std::forward<Visitor>(visitor),
+                                       std::forward<Args>(args)...);
+}
+
+// Layout optimizing tuple.
+// Members are laid out in the order of declaration, so mixing types of
+// different alignment wastes space on padding, e.g. a char followed by a
+// double. PackedTuple sorts its elements by decreasing alignment and size at
+// compile time, which leaves no padding in between. Only the tail padding to a
+// multiple of the largest alignment remains. get<I> keeps indexing the
+// elements in their original order through a compile-time permutation.
+
+// Sorts elements tagged with their original index (flat::IndexedT). Merge sort
+// is stable, so elements of the same alignment and size keep their order.
+template <typename T, typename U> struct PackedBeforeT;
+template <std::size_t I, typename T, std::size_t J, typename U>
+struct PackedBeforeT<flat::IndexedT<I, T>, flat::IndexedT<J, U>> {
+  static constexpr bool value =
+      alignof(T) > alignof(U) ||
+      (alignof(T) == alignof(U) && sizeof(T) > sizeof(U));
+};
+
+// Stores the elements in the given order as nested members, which is
+// equivalent to a struct declaring them in this order.
+template <typename... Elements> struct PackedStorage {
+  PackedStorage() = default;
+  explicit PackedStorage(std::in_place_t) {}
+};
+template <typename Head> struct PackedStorage<Head> {
+  PackedStorage() : head() {}
+  template <typename Arg>
+  PackedStorage(std::in_place_t, Arg &&arg) : head(std::forward<Arg>(arg)) {}
+
+  Head head;
+};
+template <typename Head, typename... Tail> struct PackedStorage<Head, Tail...> {
+  PackedStorage() : head(), tail() {}
+  template <typename Arg, typename... Args>
+  PackedStorage(std::in_place_t, Arg &&arg, Args &&...args)
+      : head(std::forward<Arg>(arg)),
+        tail(std::in_place, std::forward<Args>(args)...) {}
+
+  Head head;
+  PackedStorage<Tail...> tail;
+};
+
+template <std::size_t P, typename Storage>
+constexpr auto &packed_storage_get(Storage &storage) noexcept {
+  if constexpr (P == 0U)
+    return storage.head;
+  else
+    return packed_storage_get<P - 1U>(storage.tail);
+}
+
+template <typename Sorted> struct PackedSortedT;
+template <std::size_t... Is, typename... Elements>
+struct PackedSortedT<Typelist<flat::IndexedT<Is, Elements>...>> {
+  using Storage = PackedStorage<Elements...>;
+  // Original index of the element at each storage position.
+  static constexpr std::array<std::size_t, sizeof...(Is)> original_index{
+      Is...};
+};
+
+template <typename List, typename Indices> struct PackedLayoutT;
+template <typename... Elements, std::size_t... Is>
+struct PackedLayoutT<Typelist<Elements...>, std::index_sequence<Is...>>
+    : PackedSortedT<flat::MergeSort<Typelist<flat::IndexedT<Is, Elements>...>,
+                                    PackedBeforeT>> {
+  // Storage position of the element with original index I.
+  static constexpr std::size_t position(std::size_t index) noexcept {
+    auto position = std::size_t{0U};
+    while (PackedLayoutT::original_index[position] != index)
+      ++position;
+    return position;
+  }
+};
+template <typename... Elements>
+using PackedLayout = PackedLayoutT<Typelist<Elements...>,
+                                   std::index_sequence_for<Elements...>>;
+
+template <typename... Elements> class PackedTuple {
+private:
+  using Layout = PackedLayout<Elements...>;
+
+public:
+  PackedTuple() = default;
+
+  // Takes the elements in their original order.
+  template <typename... Args,
+            typename = std::enable_if_t<
+                sizeof...(Args) == sizeof...(Elements) &&
+                sizeof...(Args) != 0U &&
+                (std::is_constructible_v<Elements, Args &&> && ...)>>
+  PackedTuple(Args &&...args)
+      : PackedTuple{std::forward_as_tuple(std::forward<Args>(args)...),
+                    std::index_sequence_for<Elements...>{}} {}
+
+  template <std::size_t I> decltype(auto) get() & noexcept {
+    return packed_storage_get<Layout::position(I)>(m_storage);
+  }
+  template <std::size_t I> decltype(auto) get() const & noexcept {
+    return packed_storage_get<Layout::position(I)>(m_storage);
+  }
+  template <std::size_t I> decltype(auto) get() && noexcept {
+    using Element = flat::NthElement<Typelist<Elements...>, I>;
+    return static_cast<Element &&>(get<I>());
+  }
+
+private:
+  // Constructs the element at each storage position from the argument with
+  // the corresponding original index.
+  template <typename ArgTuple, std::size_t... Ps>
+  PackedTuple(ArgTuple &&args, std::index_sequence<Ps...>)
+      : m_storage{std::in_place,
+                  std::get<Layout::original_index[Ps]>(std::move(args))...} {}
+
+  typename Layout::Storage m_storage;
+};
+
+template <std::size_t I, typename... Elements>
+decltype(auto) get(PackedTuple<Elements...> &tuple) noexcept {
+  return tuple.template get<I>();
+}
+template <std::size_t I, typename... Elements>
+decltype(auto) get(const PackedTuple<Elements...> &tuple) noexcept {
+  return tuple.template get<I>();
+}
+template <std::size_t I, typename... Elements>
+decltype(auto) get(PackedTuple<Elements...> &&tuple) noexcept {
+  return std::move(tuple).template get<I>();
+}
+
+// Supports structured bindings.
+namespace std {
+template <typename... Elements>
+struct tuple_size<PackedTuple<Elements...>>
+    : integral_constant<size_t, sizeof...(Elements)> {};
+template <size_t I, typename... Elements>
+struct tuple_element<I, PackedTuple<Elements...>> {
+  using type = flat::NthElement<Typelist<Elements...>, I>;
+};
+} // namespace std
+
+// Record with named fields, i.e. a PackedTuple whose elements are accessed by
+// tag types instead of indices.
+template <typename Tag, typename T> struct Field {
+  using TagType = Tag;
+  using Type = T;
+};
+
+template <typename... Fields>
+class PackedRecord : public PackedTuple<typename Fields::Type...> {
+public:
+  using Tags = Typelist<typename Fields::TagType...>;
+  using PackedTuple<typename Fields::Type...>::PackedTuple;
+};
+
+template <typename Tag, typename... Fields>
+decltype(auto) get(PackedRecord<Fields...> &record) noexcept {
+  using Tags = typename PackedRecord<Fields...>::Tags;
+  return record.template get<flat::IndexOf<Tags, Tag>>();
+}
+template <typename Tag, typename... Fields>
+decltype(auto) get(const PackedRecord<Fields...> &record) noexcept {
+  using Tags = typename PackedRecord<Fields...>::Tags;
+  return record.template get<flat::IndexOf<Tags, Tag>>();
+}
+
 #endif // !CPP_TEMPLATES_CHAPTER24_TYPELISTS
@@ -1,9 +1,80 @@
 #include "chapter4_variadic_templates.hpp"
 
+#include <cassert>
+#include <sstream>
+
 int main() {
   const auto str = "grep";
   variadic_print(5.2, "hello", 69, 1.1, str);
   variadic_print_line(5.2, "hello", 69, 1.1, str);
+  print_line(5.2, "hello", 69, 1.1, str);
+
+  // Integers, floats and literals have a bounded length, only str does not
+  static_assert(FormattedSizeT<int>::value == 11U);
+  static_assert(FormattedSizeT<double>::value == 24U);
+  static_assert(FormattedSizeT<char[6]>::value == 5U);
+  static_assert(!FormattedSizeT<const char *>::bounded);
+  static_assert(LineCapacity<int, double> == 11U + 24U + 3U);
+
+  {
+    auto os = std::ostringstream{};
+    auto sink = OstreamSink{os};
+    print_line_to(sink, -2147483647 - 1, -1.5e-300, true, 'x', "hi");
+    print_line_to<','>(sink, std::string(300U, 'a'), std::string_view{"b"});
+    assert(os.str() == "-2147483648 -1.5e-300 1 x hi \n" +
+                           std::string(300U, 'a') + ",b,\n");
+  }
+
+  {
+    // All character types print as characters, as they do with std::cout
+    static_assert(FormattedSizeT<std::uint8_t>::value == 1U);
+    auto os = std::ostringstream{};
+    auto sink = OstreamSink{os};
+    print_line_to(sink, 'a', static_cast<signed char>('b'),
+                  static_cast<unsigned char>('c'));
+    assert(os.str() == "a b c \n");
+  }
+
+  {
+    auto os = std::ostringstream{};
+    {
+      auto sink = AsyncLineSink{os, 64U};
+      auto producers = std::vector<std::thread>{};
+      for (auto id = 0; id < 4; ++id)
+        producers.emplace_back([&sink, id] {
+          for (auto i = 0; i < 100; ++i)
+            sink.print_line(id, i);
+        });
+      for (auto &producer : producers)
+        producer.join();
+      sink.flush();
+      // Lines are written whole and in order per producer
+      auto is = std::istringstream{os.str()};
+      auto next = std::array<int, 4U>{};
+      auto id = 0;
+      auto i = 0;
+      while (is >> id >> i)
+        assert(next[static_cast<std::size_t>(id)]++ == i);
+      assert(next == (std::array<int, 4U>{100, 100, 100, 100}));
+      sink.print_line("async", "done");
+    }
+    assert(os.str().size() > 4U * 100U * 4U);
+    assert(os.str().substr(os.str().size() - 12U) == "async done \n");
+  }
+
+  {
+    auto os = std::ostringstream{};
+    {
+      // Flushing without pending lines must not stall the sink
+      auto sink = AsyncLineSink{os};
+      sink.print_line("a", 1);
+      sink.flush();
+      sink.flush();
+      sink.print_line("b", 2);
+      sink.flush();
+      assert(os.str() == "a 1 \nb 2 \n");
+    }
+  }
   std::cout << "Parameter pack size is " << size(5.2, "hello", 69, 1.1, str)
             << '\n';
 
@@ -24,13 +95,59 @@ int main() {
   root->left->right->right = new Node{3};
   const auto target = fold_traverse(root, left, right, right);
   std::cout << "Target node value is " << target->value << '\n';
+  assert((fold_traverse<left, right, right>(root) == target));
+
+  // Same paths through a tree stored in breadth-first order, where slot 1 is
+  // the root and slot k has children 2k and 2k + 1
+  const auto tree = EytzingerTree<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  static_assert(CompiledPath<left, right, right>::bits == 3U);
+  const auto leaf = fold_traverse(tree.root(), left, right, right);
+  assert(leaf.slot() == 11U && !leaf);
+  const auto inner = fold_traverse(tree.root(), left, right, left);
+  assert(inner == (fold_traverse<left, right, left>(tree.root())));
+  assert(inner.slot() == 10U && *inner == 4);
+  assert((!fold_traverse<left, right, right, left>(tree.root())));
+  assert(!(fold_traverse(tree.root(), left, right, right, left)));
+
+  assert(*tree.lower_bound(-1) == 0 && *tree.lower_bound(4) == 4);
+  assert(tree.lower_bound(10) == tree.end() && tree.find(7) != tree.end());
+  const int keys[] = {9, -5, 3, 42, 0, 6};
+  auto bounds = std::vector<EytzingerTree<int>::Cursor>(6U, tree.end());
+  tree.lower_bound_batch(keys, 6U, bounds.data());
+  for (auto i = 0U; i < 6U; ++i)
+    assert(bounds[i] == tree.lower_bound(keys[i]));
+
+  // Batched traversal of the same path from several nodes
+  Node *nodes[] = {root, root->left};
+  fold_traverse_batch(std::begin(nodes), std::end(nodes), right, right);
+  assert(nodes[0] == nullptr && nodes[1] == root->left->right->right);
+  EytzingerTree<int>::Cursor cursors[] = {tree.root(), tree.root()->*right};
+  fold_traverse_batch(std::begin(cursors), std::end(cursors), left, right,
+                      right, left);
+  assert(!cursors[0] && !cursors[1]);
 
   const auto str_array =
       std::array<std::string, 5U>{"darkness", "hello", "my", "friend", "old"};
   variadic_print_indices<1U, 0U, 2U, 4U, 3U>(str_array);
   variadic_print_indices(str_array, Index<1U, 0U, 2U, 4U, 3U>{});
 
-  const auto mocked_array = MockedArray{1, 2, 3, 4, 5};
+  constexpr auto mocked_array = MockedArray{1, 2, 3, 4, 5};
+  static_assert(
+      std::is_same_v<decltype(mocked_array), const MockedArray<int, 5U>>);
+  static_assert(mocked_array.size() == 5U && mocked_array[4] == 5);
+  // Five ints are padded to a 32-byte register
+  static_assert(alignof(MockedArray<int, 5U>) == 32U);
+  static_assert(sizeof(MockedArray<int, 5U>) == 32U);
+  static_assert(alignof(MockedArray<float, 3U>) == 16U);
+  static_assert(alignof(MockedArray<double, 64U>) == SimdAlignment);
+
+  constexpr auto position = MockedArray{1.0F, 2.0F, 3.0F};
+  constexpr auto velocity = MockedArray{0.5F, -1.0F, 2.0F};
+  constexpr auto next = position + 2.0F * velocity;
+  static_assert(next == MockedArray{2.0F, 0.0F, 7.0F});
+  static_assert(dot(position, velocity) == 4.5F && sum(next) == 9.0F);
+  static_assert(-(next - position) / 2.0F == -velocity);
+  static_assert(MockedArray<int, 3U>{1} == MockedArray{1, 0, 0});
 
   return 0;
 }
@@ -1,9 +1,27 @@
 #ifndef CPP_TEMPLATES_VARIADIC_TEMPLATES
 #define CPP_TEMPLATES_VARIADIC_TEMPLATES
 
+#include <algorithm>
 #include <array>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // This template gets preferred during overload resolution if trailing parameter
 // pack is empty
@@ -13,7 +31,7 @@ template <typename Arg> void variadic_print(Arg &&arg) {
 
 template <typename FirstArg, typename... Args>
 void variadic_print(FirstArg &&first_arg, Args &&...args) {
-  variadic_print(first_arg);
+  variadic_print(std::forward<FirstArg>(first_arg));
   variadic_print(std::forward<Args>(args)...);
 }
 
@@ -21,7 +39,7 @@ template <typename T, char Delimiter = ' '> class AddDelimiter {
 public:
   template <typename ValueType, typename = std::enable_if_t<std::is_same_v<
                                     std::decay_t<ValueType>, std::decay_t<T>>>>
-  explicit AddDelimiter(ValueType &&t) : value{std::move(t)} {}
+  explicit AddDelimiter(ValueType &&t) : value{std::forward<ValueType>(t)} {}
 
   friend std::ostream &operator<<(std::ostream &os,
                                   const AddDelimiter<T> &add) {
@@ -40,6 +58,241 @@ template <typename... Args> void variadic_print_line(Args &&...args) {
       << '\n';
 }
 
+// Buffered printing
+
+// variadic_print_line streams every argument (and delimiter) through
+// std::cout on its own. print_line formats the whole line into a buffer on the
+// stack first and hands it to its sink with a single write. The buffer is
+// sized at compile time from the argument types: integers and floating-point
+// numbers have a maximum length (formatted by std::to_chars, the latter in
+// their shortest round-trip representation) as do string literals. Only the
+// length of other strings is unknown, for which the buffer reserves
+// LineStringCapacity characters. Lines that exceed it are formatted into a
+// heap buffer instead, still with a single write.
+inline constexpr std::size_t LineStringCapacity = 256U;
+
+// Streams print signed and unsigned chars (and thereby std::int8_t and
+// std::uint8_t) as characters, not as numbers, and so does print_line.
+template <typename T>
+inline constexpr bool IsCharacter = std::is_same_v<T, char> ||
+                                    std::is_same_v<T, signed char> ||
+                                    std::is_same_v<T, unsigned char>;
+
+// Maximum number of characters a value of type T formats to. Unbounded types
+// (std::string, const char *) have a value of zero.
+template <typename T, typename = void> struct FormattedSizeT {
+  static constexpr bool bounded = false;
+  static constexpr std::size_t value = 0U;
+};
+template <typename T>
+struct FormattedSizeT<
+    T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_array_v<T>>> {
+  static constexpr bool bounded = true;
+  static constexpr std::size_t value = [] {
+    if constexpr (std::is_same_v<T, bool> || IsCharacter<T>)
+      return std::size_t{1U};
+    else if constexpr (std::is_integral_v<T>)
+      // All digits and the sign.
+      return static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 2U;
+    else if constexpr (std::is_floating_point_v<T>)
+      // Sign, decimal point, 'e', sign and digits of the exponent.
+      return static_cast<std::size_t>(std::numeric_limits<T>::max_digits10 +
+                                      4 + 1) +
+             (std::numeric_limits<T>::max_exponent10 >= 1000 ? 3U : 2U);
+    else
+      // Character arrays without the terminating null character.
+      return std::extent_v<T> - 1U;
+  }();
+};
+
+// Size of the stack buffer for a line, including delimiters and the newline.
+template <typename... Args>
+inline constexpr std::size_t LineCapacity =
+    (FormattedSizeT<Args>::value + ... + 0U) + sizeof...(Args) + 1U +
+    ((!FormattedSizeT<Args>::bounded || ...) ? LineStringCapacity : 0U);
+
+// Upper bound of the formatted length of value.
+template <typename T> std::size_t formatted_size(const T &value) noexcept {
+  if constexpr (FormattedSizeT<T>::bounded)
+    return FormattedSizeT<T>::value;
+  else
+    return std::string_view{value}.size();
+}
+
+// Formats value to out and returns the end of the output.
+template <typename T> char *format_value(char *out, const T &value) noexcept {
+  if constexpr (std::is_same_v<T, bool>) {
+    *out = value ? '1' : '0';
+    return out + 1;
+  } else if constexpr (IsCharacter<T>) {
+    *out = static_cast<char>(value);
+    return out + 1;
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return std::to_chars(out, out + FormattedSizeT<T>::value, value).ptr;
+  } else if constexpr (std::is_array_v<T>) {
+    // Character arrays need not be filled up to their end.
+    const auto *end = std::find(value, value + std::extent_v<T> - 1U, '\0');
+    return std::copy(value, end, out);
+  } else {
+    const auto view = std::string_view{value};
+    return std::copy(view.begin(), view.end(), out);
+  }
+}
+
+// Formats all arguments, each followed by Delimiter, and a newline to out.
+template <char Delimiter, typename... Args>
+char *format_line(char *out, const Args &...args) noexcept {
+  ((out = format_value(out, args), *out++ = Delimiter), ...);
+  *out++ = '\n';
+  return out;
+}
+
+// Sink that writes lines to an output stream.
+class OstreamSink {
+public:
+  explicit OstreamSink(std::ostream &os) noexcept : os{&os} {}
+  void write(const char *data, std::size_t size) {
+    os->write(data, static_cast<std::streamsize>(size));
+  }
+
+private:
+  std::ostream *os;
+};
+
+// Sink is any type with a write(const char *data, std::size_t size) member
+// that takes whole lines.
+template <char Delimiter = ' ', typename Sink, typename... Args>
+void print_line_to(Sink &sink, const Args &...args) {
+  constexpr auto capacity = LineCapacity<Args...>;
+  if constexpr ((!FormattedSizeT<Args>::bounded || ...)) {
+    const auto size =
+        (formatted_size(args) + ... + 0U) + sizeof...(Args) + 1U;
+    if (size > capacity) {
+      auto line = std::string(size, '\0');
+      const auto *end = format_line<Delimiter>(line.data(), args...);
+      sink.write(line.data(), static_cast<std::size_t>(end - line.data()));
+      return;
+    }
+  }
+  char line[capacity];
+  const auto *end = format_line<Delimiter>(line, args...);
+  sink.write(line, static_cast<std::size_t>(end - line));
+}
+
+// Buffered variadic_print_line.
+template <typename... Args> void print_line(const Args &...args) {
+  auto sink = OstreamSink{std::cout};
+  print_line_to(sink, args...);
+}
+
+// Sink that ships lines to a background thread, which writes them to an
+// output stream in batches. Lines are appended to the batch that is filling
+// up while the background thread writes the previous one, so producers never
+// wait for I/O unless both batches are full. The background thread picks up
+// a batch once it is half full, after FlushInterval or on flush(). Both
+// batches are allocated once and reused. Lines are never split or interleaved.
+class AsyncLineSink {
+public:
+  static constexpr auto FlushInterval = std::chrono::milliseconds{10};
+
+  explicit AsyncLineSink(std::ostream &os,
+                         std::size_t batch_capacity = 1U << 16U)
+      : os{&os}, batch_capacity{batch_capacity} {
+    filling.reserve(batch_capacity);
+    writing.reserve(batch_capacity);
+    writer = std::thread{[this] { run(); }};
+  }
+  AsyncLineSink(const AsyncLineSink &) = delete;
+  AsyncLineSink &operator=(const AsyncLineSink &) = delete;
+
+  // Writes all pending lines before returning.
+  ~AsyncLineSink() {
+    {
+      const auto lock = std::lock_guard{mutex};
+      stopping = true;
+    }
+    batch_ready.notify_one();
+    writer.join();
+  }
+
+  void write(const char *data, std::size_t size) {
+    auto lock = std::unique_lock{mutex};
+    // Waits for the background thread to take the batch if the line does not
+    // fit anymore. Lines larger than a batch make it grow.
+    if (filling.size() + size > batch_capacity && !filling.empty()) {
+      batch_ready.notify_one();
+      batch_taken.wait(lock, [this, size] {
+        return filling.size() + size <= batch_capacity || filling.empty();
+      });
+    }
+    filling.insert(filling.end(), data, data + size);
+    ++submitted;
+    if (filling.size() >= batch_capacity / 2U)
+      batch_ready.notify_one();
+  }
+
+  template <char Delimiter = ' ', typename... Args>
+  void print_line(const Args &...args) {
+    print_line_to<Delimiter>(*this, args...);
+  }
+
+  // Blocks until all lines written so far reached the stream.
+  void flush() {
+    auto lock = std::unique_lock{mutex};
+    const auto target = submitted;
+    if (written >= target)
+      return;
+    flush_requested = true;
+    batch_ready.notify_one();
+    batch_written.wait(lock, [this, target] { return written >= target; });
+  }
+
+private:
+  void run() {
+    auto lock = std::unique_lock{mutex};
+    while (true) {
+      batch_ready.wait_for(lock, FlushInterval, [this] {
+        return stopping || flush_requested ||
+               filling.size() >= batch_capacity / 2U;
+      });
+      if (filling.empty()) {
+        if (stopping)
+          return;
+        // Nothing to write, so a pending flush is already satisfied. Clearing
+        // it keeps wait_for from returning at once with the lock held.
+        flush_requested = false;
+        continue;
+      }
+      std::swap(filling, writing);
+      const auto lines = submitted;
+      flush_requested = false;
+      lock.unlock();
+      batch_taken.notify_all();
+      os->write(writing.data(), static_cast<std::streamsize>(writing.size()));
+      os->flush();
+      writing.clear();
+      lock.lock();
+      written = lines;
+      batch_written.notify_all();
+    }
+  }
+
+  std::ostream *os;
+  std::size_t batch_capacity;
+  std::mutex mutex{};
+  std::condition_variable batch_ready{};
+  std::condition_variable batch_taken{};
+  std::condition_variable batch_written{};
+  std::vector<char> filling{};
+  std::vector<char> writing{};
+  // Numbers of lines submitted by the producers and written to the stream.
+  std::uint64_t submitted{0U};
+  std::uint64_t written{0U};
+  bool flush_requested{false};
+  bool stopping{false};
+  std::thread writer{};
+};
+
 // Non-type template parameter packs also work
 template <typename std::size_t... Indices, typename Container>
 void variadic_print_indices(const Container &c) {
@@ -84,21 +337,425 @@ struct Node {
 };
 
 // Pointers to left and right members in node struct
-inline auto left = &Node::left;
-inline auto right = &Node::right;
+inline constexpr auto left = &Node::left;
+inline constexpr auto right = &Node::right;
 
 template <typename RootNode, typename... Steps>
 auto fold_traverse(RootNode &&root, Steps &&...steps) {
   return (root->*...->*steps);
 }
 
-// Mocked std::array-like container
+// Implicit tree layout
+
+// Node pointers scatter a tree over the heap, so every step of a traversal is
+// a dependent cache miss. EytzingerTree stores a complete binary tree in an
+// array in breadth-first (Eytzinger) order instead: the root is slot 1 and the
+// children of slot k are slots 2k and 2k + 1. Children are adjacent, the top
+// levels share a few cache lines and the slots four levels below a node are
+// contiguous, so they can be prefetched with a single request.
+inline constexpr std::size_t TreeAlignment = 64U;
+
+template <typename T> struct CacheAlignedAllocator {
+  using value_type = T;
+
+  CacheAlignedAllocator() noexcept = default;
+  template <typename U>
+  CacheAlignedAllocator(const CacheAlignedAllocator<U> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{TreeAlignment}));
+  }
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{TreeAlignment});
+  }
+
+  template <typename U>
+  bool operator==(const CacheAlignedAllocator<U> &) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const CacheAlignedAllocator<U> &) const noexcept {
+    return false;
+  }
+};
+
+inline void prefetch(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  static_cast<void>(address);
+#endif
+}
+
+// Number of trailing one bits of n.
+inline unsigned trailing_ones(std::size_t n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return ~n == 0U ? std::numeric_limits<std::size_t>::digits
+                  : static_cast<unsigned>(__builtin_ctzll(~n));
+#else
+  auto count = 0U;
+  for (; (n & 1U) != 0U; n >>= 1U)
+    ++count;
+  return count;
+#endif
+}
+
+// Path of left and right steps encoded as the bits of the slot it reaches
+// below the root, left being 0 and right 1.
+template <auto... Steps> struct CompiledPath {
+  static_assert(((Steps == left || Steps == right) && ...),
+                "Paths consist of left and right steps");
+  static constexpr std::size_t depth = sizeof...(Steps);
+  static constexpr std::size_t bits = [] {
+    auto bits = std::size_t{0U};
+    ((bits = (bits << 1U) | (Steps == right ? 1U : 0U)), ...);
+    return bits;
+  }();
+};
+
+// Position in an EytzingerTree. Stepping below a leaf yields the invalid
+// cursor, which stays invalid.
+template <typename T> class EytzingerCursor {
+public:
+  EytzingerCursor(const T *slots, std::size_t size, std::size_t index) noexcept
+      : slots{slots}, size{size}, index{index <= size ? index : size + 1U} {}
+
+  explicit operator bool() const noexcept { return index <= size; }
+  const T &operator*() const noexcept { return slots[index]; }
+  const T *operator->() const noexcept { return slots + index; }
+  // Slot in breadth-first order, starting with 1 at the root
+  std::size_t slot() const noexcept { return index; }
+
+  EytzingerCursor child(bool is_right) const noexcept {
+    return {slots, size,
+            index <= size ? 2U * index + static_cast<std::size_t>(is_right)
+                          : index};
+  }
+
+  // Same path syntax as for Node pointers.
+  friend EytzingerCursor operator->*(EytzingerCursor cursor,
+                                     Node *Node::*step) noexcept {
+    return cursor.child(step == right);
+  }
+
+  // Descends a path known at compile time with a single shift and add.
+  template <auto... Steps> EytzingerCursor descend() const noexcept {
+    using Path = CompiledPath<Steps...>;
+    if constexpr (Path::depth >= std::numeric_limits<std::size_t>::digits) {
+      return {slots, size, size + 1U};
+    } else {
+      if (index > (size >> Path::depth))
+        return {slots, size, size + 1U};
+      return {slots, size, (index << Path::depth) + Path::bits};
+    }
+  }
+
+  friend bool operator==(EytzingerCursor lhs, EytzingerCursor rhs) noexcept {
+    return lhs.slots == rhs.slots && lhs.index == rhs.index;
+  }
+  friend bool operator!=(EytzingerCursor lhs, EytzingerCursor rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+private:
+  const T *slots;
+  std::size_t size;
+  std::size_t index;
+};
+
+template <typename T> struct IsEytzingerCursorT : std::false_type {};
+template <typename T>
+struct IsEytzingerCursorT<EytzingerCursor<T>> : std::true_type {};
+
+// Traversal with the path given as template arguments, as in
+// fold_traverse<left, right, right>(root). Paths through an EytzingerTree
+// compile down to a single slot computation.
+template <auto... Steps, typename RootNode>
+auto fold_traverse(RootNode &&root) {
+  if constexpr (IsEytzingerCursorT<std::decay_t<RootNode>>::value)
+    return root.template descend<Steps...>();
+  else
+    return (root->*...->*Steps);
+}
+
+// Traverses the same path from every node in [first, last) and replaces each
+// node by its target. The traversals advance in lockstep and each step
+// prefetches the next node, so the memory accesses of different traversals
+// overlap instead of waiting for one another. Traversals that left the tree
+// stop at nullptr or the invalid cursor.
+template <typename NodePtr, typename... Steps>
+void fold_traverse_batch(NodePtr *first, NodePtr *last, Steps... steps) {
+  const auto step_all = [first, last](auto step) {
+    for (auto *node = first; node != last; ++node) {
+      if (!*node)
+        continue;
+      *node = *node->*step;
+      if (*node)
+        prefetch(std::addressof(**node));
+    }
+  };
+  (step_all(steps), ...);
+}
+
+// Binary search tree over sorted values in Eytzinger layout.
+template <typename T> class EytzingerTree {
+public:
+  using Cursor = EytzingerCursor<T>;
+  // Lookups in a batch that run interleaved.
+  static constexpr std::size_t BatchSize = 16U;
+
+  // Expects [first, last) to be sorted.
+  template <typename Iter> EytzingerTree(Iter first, Iter last) {
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    if (size == 0U)
+      return;
+    slots.reserve(size + 1U);
+    slots.assign(size + 1U, *first);
+    fill(first, 1U);
+    height = 0U;
+    while ((std::size_t{2U} << height) <= size)
+      ++height;
+  }
+  EytzingerTree(std::initializer_list<T> sorted)
+      : EytzingerTree(sorted.begin(), sorted.end()) {}
+
+  std::size_t size() const noexcept {
+    return slots.empty() ? 0U : slots.size() - 1U;
+  }
+  Cursor root() const noexcept { return cursor(1U); }
+  Cursor end() const noexcept { return cursor(size() + 1U); }
+
+  // First value not less than key, or end(). Prefetches the slots four
+  // levels ahead of the search.
+  Cursor lower_bound(const T &key) const noexcept {
+    const auto n = size();
+    auto k = std::size_t{1U};
+    while (k <= n) {
+      prefetch_slot(k << PrefetchLevels);
+      k = descend(k, key);
+    }
+    return found(k);
+  }
+
+  // Looks up keys[0, count) and stores the results in out. Lookups run in
+  // batches that descend one level at a time, so that the cache misses of a
+  // batch are in flight together.
+  void lower_bound_batch(const T *keys, std::size_t count,
+                         Cursor *out) const noexcept {
+    std::size_t k[BatchSize];
+    for (std::size_t begin = 0U; begin < count; begin += BatchSize) {
+      const auto batch = std::min(BatchSize, count - begin);
+      const auto *batch_keys = keys + begin;
+      std::fill_n(k, batch, std::size_t{1U});
+      // The first height levels are complete and never left early.
+      for (auto level = 0U; level < height; ++level) {
+        for (std::size_t i = 0U; i < batch; ++i) {
+          k[i] = descend(k[i], batch_keys[i]);
+          prefetch_slot(k[i]);
+        }
+      }
+      for (std::size_t i = 0U; i < batch; ++i) {
+        if (k[i] <= size())
+          k[i] = descend(k[i], batch_keys[i]);
+        out[begin + i] = found(k[i]);
+      }
+    }
+  }
+
+  Cursor find(const T &key) const noexcept {
+    const auto bound = lower_bound(key);
+    return bound && !(key < *bound) ? bound : end();
+  }
+
+private:
+  // Levels below a slot that fill one cache line.
+  static constexpr unsigned PrefetchLevels = [] {
+    auto levels = 0U;
+    while ((std::size_t{2U} << levels) * sizeof(T) <= TreeAlignment)
+      ++levels;
+    return levels;
+  }();
+
+  // Assigns the sorted values to the subtree at slot k by in-order traversal
+  // and returns the iterator past the last value it used.
+  template <typename Iter> Iter fill(Iter next, std::size_t k) {
+    if (k < slots.size()) {
+      next = fill(next, 2U * k);
+      slots[k] = *next++;
+      next = fill(next, 2U * k + 1U);
+    }
+    return next;
+  }
+
+  Cursor cursor(std::size_t k) const noexcept {
+    return {slots.data(), size(), k};
+  }
+
+  std::size_t descend(std::size_t k, const T &key) const noexcept {
+    return 2U * k + static_cast<std::size_t>(slots[k] < key);
+  }
+
+  // A search that fell off the tree at slot k last went left at the slot it
+  // looked for and only right since, so that the trailing ones of k are the
+  // steps below it. Searches for keys beyond all values only went right.
+  Cursor found(std::size_t k) const noexcept {
+    const auto slot = k >> (trailing_ones(k) + 1U);
+    return slot != 0U ? cursor(slot) : end();
+  }
+
+  // Prefetches slot k, which may be past the end of the tree.
+  void prefetch_slot(std::size_t k) const noexcept {
+    prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<std::uintptr_t>(slots.data()) + k * sizeof(T)));
+  }
+
+  // Slot 0 is unused so that children are at 2k and 2k + 1.
+  std::vector<T, CacheAlignedAllocator<T>> slots{};
+  // Number of complete levels below the root
+  unsigned height{0U};
+};
+
+// Widest SIMD register of the supported targets (AVX-512)
+inline constexpr std::size_t SimdAlignment = 64U;
+
+// Fixed-size std::array-like container for small math vectors. Its storage is
+// aligned to the smallest power of two that holds all elements, up to
+// SimdAlignment, and padded to whole multiples of it. The element-wise
+// operations run over the padding lanes as well, so that the compiler turns
+// them into aligned vector loads and stores without a scalar tail. Padding
+// lanes are value-initialized, stay zero for integers and are never observed.
+// Division and the reductions only touch the N elements.
 template <typename T, std::size_t N> class MockedArray {
+  static constexpr std::size_t Alignment = [] {
+    auto alignment = alignof(T);
+    while (alignment < N * sizeof(T) && alignment < SimdAlignment)
+      alignment *= 2U;
+    return alignment;
+  }();
+  // Number of elements including the padding lanes
+  static constexpr std::size_t Lanes =
+      Alignment % sizeof(T) == 0U
+          ? (N * sizeof(T) + Alignment - 1U) / Alignment * Alignment /
+                sizeof(T)
+          : N;
+
 public:
-  explicit MockedArray(std::initializer_list<T> &&init_list) {
-    std::cout << "MockedArray<" << typeid(T).name() << ',' << N
-              << ">::MockedArray()" << '\n';
+  constexpr MockedArray() noexcept = default;
+  // Missing elements are value-initialized
+  explicit constexpr MockedArray(std::initializer_list<T> init_list) {
+    if (init_list.size() > N)
+      throw std::length_error{"More initializers than elements"};
+    auto i = std::size_t{0U};
+    for (const auto &value : init_list)
+      values[i++] = value;
+  }
+
+  static constexpr std::size_t size() noexcept { return N; }
+  constexpr T &operator[](std::size_t i) noexcept { return values[i]; }
+  constexpr const T &operator[](std::size_t i) const noexcept {
+    return values[i];
   }
+  constexpr T *data() noexcept { return values; }
+  constexpr const T *data() const noexcept { return values; }
+  constexpr T *begin() noexcept { return values; }
+  constexpr const T *begin() const noexcept { return values; }
+  constexpr T *end() noexcept { return values + N; }
+  constexpr const T *end() const noexcept { return values + N; }
+
+  constexpr MockedArray &operator+=(const MockedArray &rhs) noexcept {
+    for (std::size_t i = 0U; i < Lanes; ++i)
+      values[i] += rhs.values[i];
+    return *this;
+  }
+  constexpr MockedArray &operator-=(const MockedArray &rhs) noexcept {
+    for (std::size_t i = 0U; i < Lanes; ++i)
+      values[i] -= rhs.values[i];
+    return *this;
+  }
+  constexpr MockedArray &operator*=(const MockedArray &rhs) noexcept {
+    for (std::size_t i = 0U; i < Lanes; ++i)
+      values[i] *= rhs.values[i];
+    return *this;
+  }
+  constexpr MockedArray &operator*=(const T &factor) noexcept {
+    for (std::size_t i = 0U; i < Lanes; ++i)
+      values[i] *= factor;
+    return *this;
+  }
+  constexpr MockedArray &operator/=(const MockedArray &rhs) noexcept {
+    for (std::size_t i = 0U; i < N; ++i)
+      values[i] /= rhs.values[i];
+    return *this;
+  }
+  constexpr MockedArray &operator/=(const T &divisor) noexcept {
+    for (std::size_t i = 0U; i < N; ++i)
+      values[i] /= divisor;
+    return *this;
+  }
+
+  friend constexpr MockedArray operator-(MockedArray array) noexcept {
+    for (std::size_t i = 0U; i < Lanes; ++i)
+      array.values[i] = -array.values[i];
+    return array;
+  }
+  friend constexpr MockedArray operator+(MockedArray lhs,
+                                         const MockedArray &rhs) noexcept {
+    return lhs += rhs;
+  }
+  friend constexpr MockedArray operator-(MockedArray lhs,
+                                         const MockedArray &rhs) noexcept {
+    return lhs -= rhs;
+  }
+  friend constexpr MockedArray operator*(MockedArray lhs,
+                                         const MockedArray &rhs) noexcept {
+    return lhs *= rhs;
+  }
+  friend constexpr MockedArray operator*(MockedArray lhs,
+                                         const T &factor) noexcept {
+    return lhs *= factor;
+  }
+  friend constexpr MockedArray operator*(const T &factor,
+                                         MockedArray rhs) noexcept {
+    return rhs *= factor;
+  }
+  friend constexpr MockedArray operator/(MockedArray lhs,
+                                         const MockedArray &rhs) noexcept {
+    return lhs /= rhs;
+  }
+  friend constexpr MockedArray operator/(MockedArray lhs,
+                                         const T &divisor) noexcept {
+    return lhs /= divisor;
+  }
+
+  friend constexpr bool operator==(const MockedArray &lhs,
+                                   const MockedArray &rhs) noexcept {
+    for (std::size_t i = 0U; i < N; ++i)
+      if (!(lhs.values[i] == rhs.values[i]))
+        return false;
+    return true;
+  }
+  friend constexpr bool operator!=(const MockedArray &lhs,
+                                   const MockedArray &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+  friend constexpr T sum(const MockedArray &array) noexcept {
+    auto total = T{};
+    for (std::size_t i = 0U; i < N; ++i)
+      total += array.values[i];
+    return total;
+  }
+  friend constexpr T dot(const MockedArray &lhs,
+                         const MockedArray &rhs) noexcept {
+    auto total = T{};
+    for (std::size_t i = 0U; i < N; ++i)
+      total += lhs.values[i] * rhs.values[i];
+    return total;
+  }
+
+private:
+  alignas(Alignment) T values[Lanes]{};
 };
 
 // Variadic Class Template Argument Deduction (CTAD) for the mocked array!
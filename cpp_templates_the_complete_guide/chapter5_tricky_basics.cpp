@@ -1,10 +1,30 @@
+// Prints the types of converting assignments.
+#define CPP_TEMPLATES_CONTAINER_WRAPPER_LOGGING 1
 #include "chapter5_tricky_basics.hpp"
+#include <cassert>
+#include <string>
 
 int main() {
   const auto int_wrapper = ContainerWrapper<int, std::vector>{};
   auto double_wrapper = ContainerWrapper<double, std::deque>{};
   double_wrapper = int_wrapper;
 
+  // Assignments reuse the elements that are already there.
+  auto ints = ContainerWrapper<int, std::vector>{std::vector<int>{1, 2, 3}};
+  auto longs = ContainerWrapper<long, std::deque>{std::deque<long>(5U, 0L)};
+  longs = ints;
+  assert((longs.container() == std::deque<long>{1, 2, 3}));
+  ints = ContainerWrapper<int, std::deque>{std::deque<int>{4, 5, 6, 7}};
+  assert((ints.container() == std::vector<int>{4, 5, 6, 7}));
+
+  // Rvalue sources are moved from.
+  auto source = ContainerWrapper<std::string, std::deque>{
+      std::deque<std::string>{std::string(32U, 'x')}};
+  auto strings = ContainerWrapper<std::string, std::vector>{};
+  strings = std::move(source);
+  assert(strings.container().front() == std::string(32U, 'x'));
+  assert(source.container().empty());
+
   const auto bs = std::bitset<10U>{420U};
   print_bitset(bs);
 
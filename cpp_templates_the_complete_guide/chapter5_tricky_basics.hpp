@@ -1,12 +1,35 @@
 #ifndef CPP_TEMPLATES_CHAPTER5_TRICKY_BASICS
 #define CPP_TEMPLATES_CHAPTER5_TRICKY_BASICS
 
+#include "chapter20_overloading_on_type_properties.hpp"
+#include <algorithm>
 #include <bitset>
 #include <deque>
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+// Assignments between ContainerWrappers of different types log their types to
+// std::cout if compiled with -DCPP_TEMPLATES_CONTAINER_WRAPPER_LOGGING=1.
+// Writing to std::cout is synchronous I/O, so it is off by default.
+#ifndef CPP_TEMPLATES_CONTAINER_WRAPPER_LOGGING
+#define CPP_TEMPLATES_CONTAINER_WRAPPER_LOGGING 0
+#endif
+inline constexpr bool ContainerWrapperLogging =
+    CPP_TEMPLATES_CONTAINER_WRAPPER_LOGGING != 0;
+
+// Detects containers that can reserve capacity (std::vector, but not
+// std::deque).
+template <typename C, typename = std::void_t<>>
+struct HasReserve : std::false_type {};
+template <typename C>
+struct HasReserve<C, std::void_t<decltype(std::declval<C &>().reserve(
+                         std::declval<std::size_t>()))>> : std::true_type {};
+
 // The template template idiom that allows us to specify the template taking a
 // value and container type like this: ContainerWrapper<int, std::vector>.
 // The Container template parameter is therefore itself a class template.
@@ -17,6 +40,11 @@ template <typename T,
           template <typename E, typename = std::allocator<E>> class Container>
 class ContainerWrapper {
 public:
+  ContainerWrapper() = default;
+  explicit ContainerWrapper(Container<T> data) : data{std::move(data)} {}
+
+  const Container<T> &container() const noexcept { return data; }
+
   // Enables copy-assignment for types T_ that can be implicitly converted to T
   // This does not disable the implicit generation of special member functions,
   // so for std::is_same_v<T,T_>==true, the implicitly generated copy-assignment
@@ -27,6 +55,10 @@ public:
   template <typename T_, template <typename E_, typename = std::allocator<E_>>
                          class Container_>
   ContainerWrapper &operator=(const ContainerWrapper<T_, Container_> &rhs);
+  // Moves the elements of rhs instead of copying them.
+  template <typename T_, template <typename E_, typename = std::allocator<E_>>
+                         class Container_>
+  ContainerWrapper &operator=(ContainerWrapper<T_, Container_> &&rhs);
 
   // Allow access to private members between all specialized class templates.
   // Since we do not refer to the type and class names, we can omit them here.
@@ -34,6 +66,33 @@ public:
   friend class ContainerWrapper;
 
 private:
+  template <typename T_, template <typename E_, typename = std::allocator<E_>>
+                         class Container_>
+  static void log_assignment(const char *qualifier, const char *reference) {
+    std::cout << "ContainerWrapper<" << typeid(T).name() << ','
+              << typeid(Container<T>).name() << ">::operator=(" << qualifier
+              << "ContainerWrapper<" << typeid(T_).name() << ','
+              << typeid(Container_<T_>).name() << "> " << reference << "rhs)"
+              << '\n';
+  }
+
+  // Assigns over the elements that exist on both sides, which bulk_copy turns
+  // into a single memmove for contiguous containers of the same trivially
+  // copyable type, and only inserts or erases the difference. Growing
+  // containers reserve their final size first, so they reallocate at most
+  // once.
+  template <typename Iter>
+  void assign(Iter first, Iter last, std::size_t size) {
+    if constexpr (HasReserve<Container<T>>::value)
+      data.reserve(size);
+    const auto common = std::min(data.size(), size);
+    const auto common_end =
+        std::next(first, static_cast<std::ptrdiff_t>(common));
+    const auto end = bulk_copy(first, common_end, data.begin());
+    data.erase(end, data.end());
+    data.insert(data.end(), common_end, last);
+  }
+
   Container<T> data;
 };
 
@@ -43,13 +102,29 @@ template <typename T_, template <typename E_, typename = std::allocator<E_>>
                        class Container_>
 ContainerWrapper<T, Container> &ContainerWrapper<T, Container>::operator=(
     const ContainerWrapper<T_, Container_> &rhs) {
-  std::cout << "ContainerWrapper<" << typeid(T).name() << ','
-            << typeid(Container<T>).name()
-            << ">::operator=(const ContainerWrapper<" << typeid(T_).name()
-            << ',' << typeid(Container_<T_>).name() << "> &rhs)" << '\n';
-  data.clear();
+  if constexpr (ContainerWrapperLogging)
+    log_assignment<T_, Container_>("const ", "&");
   // Friend declaration allows us to access rhs.data here
-  data.insert(data.begin(), rhs.data.begin(), rhs.data.end());
+  assign(rhs.data.begin(), rhs.data.end(), rhs.data.size());
+  return *this;
+}
+
+template <typename T,
+          template <typename E, typename = std::allocator<E>> class Container>
+template <typename T_, template <typename E_, typename = std::allocator<E_>>
+                       class Container_>
+ContainerWrapper<T, Container> &ContainerWrapper<T, Container>::operator=(
+    ContainerWrapper<T_, Container_> &&rhs) {
+  if constexpr (ContainerWrapperLogging)
+    log_assignment<T_, Container_>("", "&&");
+  // Moving trivially copyable elements is copying them, which keeps the
+  // memmove path of bulk_copy open.
+  if constexpr (std::is_trivially_copyable_v<T_>)
+    assign(rhs.data.begin(), rhs.data.end(), rhs.data.size());
+  else
+    assign(std::make_move_iterator(rhs.data.begin()),
+           std::make_move_iterator(rhs.data.end()), rhs.data.size());
+  rhs.data.clear();
   return *this;
 }
 
@@ -1,5 +1,41 @@
 #include "chapter8_compile_time_programming.hpp"
 
+#include <cassert>
+
+constexpr std::string_view colors[] = {"red", "green", "blue", "cyan",
+                                       "magenta", "yellow"};
+enum class Color { Red, Green, Blue, Cyan, Magenta, Yellow };
+
+constexpr auto color_table = make_perfect_hash(colors);
+static_assert(color_table.find("magenta") ==
+              static_cast<std::size_t>(Color::Magenta));
+static_assert(color_table.find("Magenta") == color_table.npos);
+static_assert(!color_table.contains("black"));
+static_assert(!color_table.contains(""));
+
+constexpr std::string_view keywords[] = {
+    "alignas", "alignof", "auto", "bool", "break", "case", "catch", "char",
+    "class", "const", "constexpr", "continue", "decltype", "default", "delete",
+    "do", "double", "else", "enum", "explicit", "extern", "false", "float",
+    "for", "friend", "goto", "if", "inline", "int", "long", "mutable",
+    "namespace", "new", "noexcept", "nullptr", "operator", "private",
+    "protected", "public", "return", "short", "signed", "sizeof", "static",
+    "struct", "switch", "template", "this", "throw", "true", "try", "typedef",
+    "typename", "union", "unsigned", "using", "virtual", "void", "volatile",
+    "while"};
+
+constexpr auto keyword_table = make_perfect_hash<CaseInsensitiveFold>(keywords);
+static_assert(keyword_table.find("TEMPLATE") == 46U);
+static_assert(keyword_table.find("Typename") == 52U);
+
+static_assert(primes::is_prime(2U) && primes::is_prime(3U));
+static_assert(!primes::is_prime(1U) && !primes::is_prime(25U));
+static_assert(primes::is_prime(1000000007U));
+static_assert(primes::next_prime(1000U) == 1009U);
+static_assert(primes::PrimeTable<30U>.size() == 10U);
+static_assert(primes::PrimeTable<30U>.back() == 29U);
+static_assert(primes::PrimeTable<10000U>.size() == 1229U);
+
 int main() {
   std::ignore = cpp98::Alternative<69U>{};
   std::ignore = cpp98::Alternative<31U>{};
@@ -14,5 +50,31 @@ int main() {
   std::string str = {"friend"};
   print(5.2, "hello", 69, 1.1, str);
 
+  for (std::size_t i = 0U; i < keyword_table.size(); ++i)
+    assert(keyword_table.find(keywords[i]) == i);
+  assert(keyword_table.find("WHILE") == 59U);
+  assert(!keyword_table.contains("whilst"));
+  assert(keyword_table.contains(str));
+  assert(!keyword_table.contains(str + "ly"));
+
+  // The segmented sieve agrees with the compile-time table and the trial
+  // divisions, also across segment boundaries.
+  const auto runtime_primes = primes::primes_below(10000U);
+  assert(std::equal(runtime_primes.begin(), runtime_primes.end(),
+                    primes::PrimeTable<10000U>.begin(),
+                    primes::PrimeTable<10000U>.end()));
+  const auto many_primes = primes::primes_below(1000000U);
+  assert(many_primes.size() == 78498U);
+  for (std::size_t p = 999000U; p < 1000000U; ++p) {
+    assert(primes::is_prime(p) == cpp14::is_prime(p));
+    assert(primes::is_prime(p) == std::binary_search(many_primes.begin(),
+                                                     many_primes.end(), p));
+  }
+  for (std::size_t n = 0U; n < 100U; ++n)
+    assert(primes::primes_below(n).size() ==
+           static_cast<std::size_t>(std::count_if(
+               primes::PrimeTable<100U>.begin(), primes::PrimeTable<100U>.end(),
+               [n](std::size_t p) { return p < n; })));
+
   return 0;
 }
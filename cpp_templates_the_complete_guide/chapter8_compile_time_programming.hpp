@@ -1,9 +1,18 @@
 #ifndef CPP_TEMPLATES_CHAPTER8_COMPILE_TIME_PROGRAMMING
 #define CPP_TEMPLATES_CHAPTER8_COMPILE_TIME_PROGRAMMING
 
+#include "../exceptional_cpp/case_insensitive_string.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 // C++98 compile-time is_prime
 namespace cpp98 {
@@ -96,6 +105,140 @@ template <std::size_t N> void foo() {
 
 } // namespace cpp14
 
+// Faster primality tests and prime tables
+namespace primes {
+
+// A composite p has a divisor d <= sqrt(p), so trial division can stop there.
+// Apart from 2 and 3, all primes are of the form 6k - 1 or 6k + 1, which skips
+// two thirds of the remaining candidates. d <= p / d avoids overflowing d * d.
+constexpr bool is_prime(std::size_t p) noexcept {
+  if (p < 4U)
+    return p > 1U;
+  if (p % 2U == 0U || p % 3U == 0U)
+    return false;
+  for (std::size_t d = 5U; d <= p / d; d += 6U) {
+    if (p % d == 0U || p % (d + 2U) == 0U)
+      return false;
+  }
+  return true;
+}
+
+template <std::size_t P> struct IsPrimeT {
+  static constexpr bool value = is_prime(P);
+};
+
+// Smallest prime that is at least n, e.g. for sizing hash table buckets.
+constexpr std::size_t next_prime(std::size_t n) noexcept {
+  while (!is_prime(n))
+    ++n;
+  return n;
+}
+
+// Largest r with r * r <= n.
+constexpr std::size_t isqrt(std::size_t n) noexcept {
+  auto r = std::size_t{0U};
+  for (auto bit = std::size_t{1U} << (4U * sizeof(std::size_t) - 1U);
+       bit != 0U; bit >>= 1U) {
+    const auto candidate = r | bit;
+    if (candidate <= n / candidate)
+      r = candidate;
+  }
+  return r;
+}
+
+// Sieve of Eratosthenes, composite[i] is true iff i is not prime.
+template <std::size_t N> constexpr std::array<bool, N> sieve() noexcept {
+  std::array<bool, N> composite{};
+  for (std::size_t i = 0U; i < N && i < 2U; ++i)
+    composite[i] = true;
+  for (std::size_t p = 2U; p <= isqrt(N); ++p) {
+    if (composite[p])
+      continue;
+    for (auto multiple = p * p; multiple < N; multiple += p)
+      composite[multiple] = true;
+  }
+  return composite;
+}
+
+template <std::size_t N> constexpr std::size_t prime_count() noexcept {
+  const auto composite = sieve<N>();
+  auto count = std::size_t{0U};
+  for (const auto is_composite : composite)
+    count += is_composite ? 0U : 1U;
+  return count;
+}
+
+template <std::size_t N> constexpr auto make_prime_table() noexcept {
+  const auto composite = sieve<N>();
+  std::array<std::size_t, prime_count<N>()> table{};
+  auto count = std::size_t{0U};
+  for (std::size_t i = 0U; i < N; ++i) {
+    if (!composite[i])
+      table[count++] = i;
+  }
+  return table;
+}
+
+// All primes below N in ascending order, computed at compile time. Unlike
+// recursive templates, the cost is linear in N and independent of the
+// template instantiation depth.
+template <std::size_t N>
+inline constexpr std::array<std::size_t, prime_count<N>()> PrimeTable =
+    make_prime_table<N>();
+
+// Runtime sieve for large limits. A plain sieve of Eratosthenes strides through
+// the whole array once per prime, which misses the cache as soon as the array
+// outgrows it. The segmented sieve processes the range in blocks that fit into
+// the L1 cache and crosses off the multiples of all primes up to sqrt(n) in
+// each block before moving on. Only odd numbers are stored.
+inline constexpr std::size_t SieveSegmentSize = 32U * 1024U;
+
+inline std::vector<std::size_t> primes_below(std::size_t n) {
+  auto primes = std::vector<std::size_t>{};
+  if (n <= 2U)
+    return primes;
+  primes.push_back(2U);
+
+  // Odd primes up to sqrt(n) together with the index of their next odd
+  // multiple relative to the current segment.
+  const auto limit = isqrt(n - 1U);
+  auto base = std::vector<std::size_t>{};
+  auto next = std::vector<std::size_t>{};
+  {
+    auto composite = std::vector<bool>(limit + 1U, false);
+    for (std::size_t p = 3U; p <= limit; p += 2U) {
+      if (composite[p])
+        continue;
+      base.push_back(p);
+      next.push_back((p * p - 1U) / 2U);
+      for (auto multiple = p * p; multiple <= limit; multiple += 2U * p)
+        composite[multiple] = true;
+    }
+  }
+
+  // Index i of the odd numbers represents 2 * i + 1, index 0 (for 1) is
+  // skipped.
+  const auto odd_count = n / 2U;
+  auto segment = std::vector<unsigned char>(SieveSegmentSize);
+  for (std::size_t low = 1U; low < odd_count; low += SieveSegmentSize) {
+    const auto high = std::min(low + SieveSegmentSize, odd_count);
+    std::fill(segment.begin(), segment.end(), 0U);
+    for (std::size_t k = 0U; k < base.size(); ++k) {
+      auto index = next[k];
+      for (; index < high; index += base[k])
+        segment[index - low] = 1U;
+      next[k] = index;
+    }
+    for (auto index = low; index < high; ++index) {
+      if (segment[index - low] == 0U)
+        primes.push_back(2U * index + 1U);
+    }
+  }
+  return primes;
+}
+
+} // namespace primes
+
 template <typename FirstArg, typename... Args>
 void print(FirstArg &&first_arg, Args &&...args) {
   std::cout << first_arg << ' ';
@@ -136,4 +279,181 @@ auto safe_len(const T &t) -> decltype((void)(t.size)(), T::size_type()) {
 
 inline std::size_t safe_len(...) { return std::size_t{}; }
 
+// Compile-time perfect hashing
+
+// For a fixed set of keys known at compile time, a constexpr function can
+// search for a hash function without any collisions while compiling. A lookup
+// then hashes the key once, reads a single slot and compares a single key,
+// which beats both the string compares of a linear scan and the bucket chains
+// of std::unordered_map.
+//
+// The construction uses hash and displace: the keys are first distributed
+// over buckets by their hash. Starting with the largest bucket, a seed is
+// searched per bucket that maps all of its keys to slots that are still free.
+// A lookup mixes the hash of the key with the seed of its bucket to find the
+// slot.
+
+// Fold policies determine which characters compare equal.
+struct ExactFold {
+  static constexpr char fold(char ch) noexcept { return ch; }
+};
+
+struct CaseInsensitiveFold {
+  static constexpr char fold(char ch) noexcept { return to_lower(ch); }
+};
+
+// Finalizer of MurmurHash3, every input bit affects every output bit.
+constexpr std::uint64_t perfect_hash_mix(std::uint64_t h) noexcept {
+  h ^= h >> 33U;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33U;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33U;
+  return h;
+}
+
+// FNV-1a over the folded characters.
+template <typename Fold>
+constexpr std::uint64_t perfect_hash_key(std::string_view key) noexcept {
+  auto h = 0xcbf29ce484222325ULL;
+  for (const auto ch : key) {
+    h ^= static_cast<unsigned char>(Fold::fold(ch));
+    h *= 0x100000001b3ULL;
+  }
+  return perfect_hash_mix(h);
+}
+
+constexpr std::uint64_t perfect_hash_slot(std::uint64_t h,
+                                          std::uint64_t seed) noexcept {
+  return perfect_hash_mix(h ^ (seed * 0x9e3779b97f4a7c15ULL));
+}
+
+template <typename Fold>
+constexpr bool perfect_hash_equal(std::string_view lhs,
+                                  std::string_view rhs) noexcept {
+  if (lhs.size() != rhs.size())
+    return false;
+  for (std::size_t i = 0U; i < lhs.size(); ++i) {
+    if (Fold::fold(lhs[i]) != Fold::fold(rhs[i]))
+      return false;
+  }
+  return true;
+}
+
+// Smallest power of two that is at least n. The slot index is then computed
+// with a mask instead of a division.
+constexpr std::size_t perfect_hash_capacity(std::size_t n) noexcept {
+  auto capacity = std::size_t{1U};
+  while (capacity < n)
+    capacity *= 2U;
+  return capacity;
+}
+
+template <std::size_t N, typename Fold = ExactFold> class PerfectHashTable {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+  static constexpr std::size_t Capacity = perfect_hash_capacity(N);
+
+  // Throws on duplicate keys or if no seeds are found. Called in a constant
+  // expression, this is a compile-time error.
+  constexpr explicit PerfectHashTable(const std::string_view (&keys)[N]) {
+    for (std::size_t i = 0U; i < N; ++i) {
+      m_keys[i] = keys[i];
+      for (std::size_t j = 0U; j < i; ++j) {
+        if (perfect_hash_equal<Fold>(keys[i], keys[j]))
+          throw std::invalid_argument{"duplicate perfect hash key"};
+      }
+    }
+    build();
+  }
+
+  // Returns the index of key in the array of keys or npos.
+  constexpr std::size_t find(std::string_view key) const noexcept {
+    const auto h = perfect_hash_key<Fold>(key);
+    const auto seed = m_seeds[h & Mask];
+    const auto index = m_slots[perfect_hash_slot(h, seed) & Mask];
+    if (index != npos && perfect_hash_equal<Fold>(m_keys[index], key))
+      return index;
+    return npos;
+  }
+
+  constexpr bool contains(std::string_view key) const noexcept {
+    return find(key) != npos;
+  }
+
+  static constexpr std::size_t size() noexcept { return N; }
+  constexpr std::string_view operator[](std::size_t index) const noexcept {
+    return m_keys[index];
+  }
+
+private:
+  static constexpr std::size_t Mask = Capacity - 1U;
+  // Generous bound, larger buckets usually need tens of attempts.
+  static constexpr std::uint64_t MaxSeed = 1U << 16U;
+
+  constexpr void build() {
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, Capacity> bucket_sizes{};
+    for (std::size_t i = 0U; i < N; ++i) {
+      hashes[i] = perfect_hash_key<Fold>(m_keys[i]);
+      ++bucket_sizes[hashes[i] & Mask];
+    }
+    for (auto &index : m_slots)
+      index = npos;
+
+    // Buckets by decreasing size (insertion sort, std::sort is not constexpr
+    // before C++20). Large buckets are placed while most slots are free.
+    std::array<std::size_t, Capacity> order{};
+    for (std::size_t b = 0U; b < Capacity; ++b) {
+      auto pos = b;
+      for (; pos > 0U && bucket_sizes[order[pos - 1U]] < bucket_sizes[b]; --pos)
+        order[pos] = order[pos - 1U];
+      order[pos] = b;
+    }
+
+    for (const auto bucket : order) {
+      if (bucket_sizes[bucket] == 0U)
+        break;
+      m_seeds[bucket] = find_seed(bucket, hashes);
+      for (std::size_t i = 0U; i < N; ++i) {
+        if ((hashes[i] & Mask) == bucket)
+          m_slots[perfect_hash_slot(hashes[i], m_seeds[bucket]) & Mask] = i;
+      }
+    }
+  }
+
+  constexpr std::uint64_t
+  find_seed(std::size_t bucket, const std::array<std::uint64_t, N> &hashes) {
+    for (std::uint64_t seed = 1U; seed < MaxSeed; ++seed) {
+      if (fits(bucket, seed, hashes))
+        return seed;
+    }
+    throw std::logic_error{"no perfect hash seed found"};
+  }
+
+  // True iff seed maps all keys of bucket to distinct free slots.
+  constexpr bool fits(std::size_t bucket, std::uint64_t seed,
+                      const std::array<std::uint64_t, N> &hashes) const {
+    std::array<bool, Capacity> taken{};
+    for (std::size_t i = 0U; i < N; ++i) {
+      if ((hashes[i] & Mask) != bucket)
+        continue;
+      const auto slot = perfect_hash_slot(hashes[i], seed) & Mask;
+      if (m_slots[slot] != npos || taken[slot])
+        return false;
+      taken[slot] = true;
+    }
+    return true;
+  }
+
+  std::array<std::string_view, N> m_keys{};
+  std::array<std::uint64_t, Capacity> m_seeds{};
+  std::array<std::size_t, Capacity> m_slots{};
+};
+
+template <typename Fold = ExactFold, std::size_t N>
+constexpr auto make_perfect_hash(const std::string_view (&keys)[N]) {
+  return PerfectHashTable<N, Fold>{keys};
+}
+
 #endif // !CPP_TEMPLATES_CHAPTER8_COMPILE_TIME_PROGRAMMING
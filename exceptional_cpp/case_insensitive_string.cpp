@@ -2,6 +2,24 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <string_view>
+
+// Keyword tables can be searched at compile time.
+constexpr CIStringView keywords[] = {"select", "from", "where"};
+
+constexpr auto is_keyword(CIStringView word) noexcept {
+  for (const auto &keyword : keywords) {
+    if (keyword == word)
+      return true;
+  }
+  return false;
+}
+
+static_assert(is_keyword("SELECT"));
+static_assert(is_keyword("WhErE"));
+static_assert(!is_keyword("selec"));
+static_assert(CIStringView{"abc"} != CIStringView{"abcd"});
 
 int main() {
   const auto s = ci_string{"AbCdE?"};
@@ -16,5 +34,73 @@ int main() {
   assert(std::strcmp(s.c_str(), "abcdef?") != 0);
   assert(std::strcmp(s.c_str(), "AbCdEf?") != 0);
 
+  // Long enough to be compared in SIMD blocks.
+  const auto header =
+      ascii_ci_string{"Content-Type-Options-And-Some-More-Text"};
+  assert(header == "content-type-options-and-some-more-text");
+  assert(header == "CONTENT-TYPE-OPTIONS-AND-SOME-MORE-TEXT");
+  assert(header != "content-type-options-and-some-more-texT!");
+  assert(header < "content-type-options-and-some-more-tExu");
+  assert(header.find('x') == 37U);
+  assert(header.find('X') == 37U);
+  assert(header.find('@') == ascii_ci_string::npos);
+  // Non-ASCII characters take the per-character path.
+  const auto non_ascii =
+      ascii_ci_string{"Stra\xdf\x65-And-Some-More-Text-To-Fill-It"};
+  assert(non_ascii == "STRA\xdf\x45-and-some-more-text-to-fill-it");
+
+  // Equal strings hash equally regardless of case and string type.
+  const auto hash = ci_hash{};
+  assert(hash(header) == hash("CONTENT-TYPE-OPTIONS-AND-SOME-MORE-TEXT"));
+  assert(hash(s) == hash(CIString{"abcde?"}));
+  assert(hash(s) != hash("abcde!"));
+  assert(hash("") != hash("a"));
+  assert(std::hash<ci_string>{}(s) == std::hash<CIString>{}("ABCDE?"));
+
+  // Short strings are stored inline, long ones on the heap.
+  const auto small = CIString{"Accept"};
+  const auto large = CIString{"Access-Control-Allow-Origin-Headers"};
+  assert(small == "ACCEPT");
+  assert(small != "ACCEPTS");
+  assert(small != "ACCEPU");
+  assert(large == "access-control-allow-origin-headers");
+  assert(large != "access-control-allow-origin-headerz");
+  assert(CIString{"Stra\xdf\x65"} != "STRA\xdf\x45!");
+  assert(CIString{"Stra\xdf\x65"} == "STRA\xdf\x45");
+  assert(CIString{"Stra\xdf\x65"} != "STRA\xff\x45");
+  assert(small.size() == 6U && large.size() == 35U);
+  assert(small.hash() == hash("aCcEpT"));
+  assert(CIStringView{large} == "ACCESS-CONTROL-ALLOW-ORIGIN-HEADERS");
+
+  auto copy = large;
+  auto moved = std::move(copy);
+  assert(moved == large && std::strcmp(moved.c_str(), large.c_str()) == 0);
+  assert(copy.empty() && copy == "");
+  assert(CIString{} == copy && CIString{}.hash() == hash(""));
+  copy = small;
+  assert(copy == small);
+  moved = std::move(copy);
+  assert(moved == small && copy.empty());
+
+  auto headers = CIFlatMap<int>{};
+  for (auto i = 0; i < 100; ++i)
+    headers[std::to_string(i) + "-Header"] = i;
+  assert(headers.size() == 100U);
+  assert(headers.try_emplace("Content-Length", 42).second);
+  assert(!headers.try_emplace("content-length", 0).second);
+  assert(*headers.find(std::string_view{"CONTENT-LENGTH"}) == 42);
+  assert(*headers.find(ci_string{"17-header"}) == 17);
+  assert(headers.contains(CIString{"99-HEADER"}));
+  assert(!headers.contains("100-header"));
+  // Default views have a null data()
+  assert(!headers.contains(std::string_view{}));
+  assert(CIString{std::string_view{}} == CIString{});
+  for (auto i = 0; i < 100; i += 2)
+    assert(headers.erase(std::to_string(i) + "-HEADER"));
+  assert(!headers.erase("0-header"));
+  assert(headers.size() == 51U);
+  for (auto i = 1; i < 100; i += 2)
+    assert(*headers.find(std::to_string(i) + "-header") == i);
+
   return 0;
 }
@@ -1,22 +1,29 @@
+#ifndef EXCEPTIONAL_CPP_CASE_INSENSITIVE_STRING
+#define EXCEPTIONAL_CPP_CASE_INSENSITIVE_STRING
+
+#include "multiply_fold.hpp"
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 
-// My first try
-
-class CIString {
-public:
-  CIString(const char *str) noexcept : m_str{str} {}
-  constexpr auto c_str() const noexcept { return m_str; }
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
-  friend constexpr auto operator==(const CIString &lhs,
-                                   const CIString &rhs) noexcept;
-  friend constexpr auto operator!=(const CIString &lhs,
-                                   const CIString &rhs) noexcept;
+// My first try
 
-private:
-  const char *m_str;
-};
+// Non-owning view of a string literal that carries its length, so comparisons
+// of strings with different lengths return immediately. Everything is
+// constexpr, which makes it usable for keyword tables evaluated at compile
+// time. The owning CIString further below is the runtime counterpart.
 
 inline constexpr auto to_lower(char ch) noexcept {
   const auto dec = static_cast<uint8_t>(ch);
@@ -25,19 +32,47 @@ inline constexpr auto to_lower(char ch) noexcept {
   return ch;
 }
 
-constexpr auto operator==(const CIString &lhs, const CIString &rhs) noexcept {
-  auto l_ptr = lhs.c_str();
-  auto r_ptr = rhs.c_str();
-  while (*l_ptr != '\0' && *r_ptr != '\0') {
-    if (!(to_lower(*l_ptr) == to_lower(*r_ptr)))
+class CIStringView {
+public:
+  constexpr CIStringView() noexcept = default;
+  constexpr CIStringView(const char *str) noexcept
+      : m_str{str}, m_size{length(str)} {}
+  constexpr CIStringView(const char *str, std::size_t size) noexcept
+      : m_str{str}, m_size{size} {}
+
+  constexpr auto data() const noexcept { return m_str; }
+  constexpr auto size() const noexcept { return m_size; }
+
+  friend constexpr auto operator==(const CIStringView &lhs,
+                                   const CIStringView &rhs) noexcept;
+  friend constexpr auto operator!=(const CIStringView &lhs,
+                                   const CIStringView &rhs) noexcept;
+
+private:
+  static constexpr std::size_t length(const char *str) noexcept {
+    auto size = std::size_t{0U};
+    while (str[size] != '\0')
+      ++size;
+    return size;
+  }
+
+  const char *m_str{""};
+  std::size_t m_size{0U};
+};
+
+constexpr auto operator==(const CIStringView &lhs,
+                          const CIStringView &rhs) noexcept {
+  if (lhs.size() != rhs.size())
+    return false;
+  for (auto i = std::size_t{0U}; i < lhs.size(); ++i) {
+    if (!(to_lower(lhs.data()[i]) == to_lower(rhs.data()[i])))
       return false;
-    l_ptr++;
-    r_ptr++;
   }
-  return *l_ptr == *r_ptr;
+  return true;
 }
 
-constexpr auto operator!=(const CIString &lhs, const CIString &rhs) noexcept {
+constexpr auto operator!=(const CIStringView &lhs,
+                          const CIStringView &rhs) noexcept {
   return !(lhs == rhs);
 }
 
@@ -73,3 +108,551 @@ struct ci_char_traits : public std::char_traits<char> {
   }
 };
 using ci_string = std::basic_string<char, ci_char_traits>;
+
+// Faster solution for ASCII
+
+// std::toupper depends on the current locale and is an opaque library call
+// that cannot be inlined, let alone vectorized. For ASCII characters, case
+// folding is much simpler: lower and upper case letters only differ in the
+// bit 0x20. We can therefore fold case branchlessly and for many characters at
+// once with SIMD instructions. Characters outside of ASCII (high bit set) are
+// still handed to ci_char_traits as their case depends on the locale.
+struct ascii_ci_char_traits : public std::char_traits<char> {
+  static constexpr bool is_ascii(char ch) noexcept {
+    return (static_cast<unsigned char>(ch) & 0x80U) == 0U;
+  }
+
+  // Clears the bit 0x20 iff ch is in [a, z]. The subtraction wraps around for
+  // characters below 'a', so a single comparison checks both bounds.
+  static constexpr char fold(char ch) noexcept {
+    const auto uch = static_cast<unsigned char>(ch);
+    const auto is_lower = static_cast<unsigned char>(uch - 'a') < 26U;
+    return static_cast<char>(uch & ~(static_cast<unsigned>(is_lower) << 5U));
+  }
+
+  static bool eq(char c1, char c2) {
+    if (!is_ascii(c1) || !is_ascii(c2))
+      return ci_char_traits::eq(c1, c2);
+    return fold(c1) == fold(c2);
+  }
+
+  static bool lt(char c1, char c2) {
+    if (!is_ascii(c1) || !is_ascii(c2))
+      return ci_char_traits::lt(c1, c2);
+    return fold(c1) < fold(c2);
+  }
+
+  static int compare(const char *s1, const char *s2, std::size_t n) {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    for (; n - i >= Block::size; i += Block::size) {
+      const auto b1 = Block::load(s1 + i);
+      const auto b2 = Block::load(s2 + i);
+      if (Block::any_non_ascii(b1, b2)) {
+        if (const auto result =
+                ci_char_traits::compare(s1 + i, s2 + i, Block::size))
+          return result;
+        continue;
+      }
+      const auto mismatches =
+          Block::mismatches(Block::fold(b1), Block::fold(b2));
+      if (mismatches != 0U) {
+        const auto at = i + Block::first(mismatches);
+        return fold(s1[at]) < fold(s2[at]) ? -1 : 1;
+      }
+    }
+#endif
+    for (; i < n; ++i) {
+      if (!eq(s1[i], s2[i]))
+        return lt(s1[i], s2[i]) ? -1 : 1;
+    }
+    return 0;
+  }
+
+  // Case-insensitive equality that only folds ASCII letters and compares all
+  // other characters exactly, independent of the locale. This never needs the
+  // per-character fallback.
+  static bool equal_ascii(const char *s1, const char *s2,
+                          std::size_t n) noexcept {
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    for (; n - i >= Block::size; i += Block::size) {
+      const auto b1 = Block::fold(Block::load(s1 + i));
+      const auto b2 = Block::fold(Block::load(s2 + i));
+      if (Block::mismatches(b1, b2) != 0U)
+        return false;
+    }
+#endif
+    for (; i < n; ++i) {
+      if (fold(s1[i]) != fold(s2[i]))
+        return false;
+    }
+    return true;
+  }
+
+  static const char *find(const char *s, std::size_t n, char a) {
+    if (!is_ascii(a))
+      return ci_char_traits::find(s, n, a);
+    std::size_t i = 0U;
+#if defined(__SSE2__)
+    const auto needle = Block::splat(fold(a));
+    for (; n - i >= Block::size; i += Block::size) {
+      const auto block = Block::load(s + i);
+      if (Block::any_non_ascii(block, block)) {
+        if (const auto found = ci_char_traits::find(s + i, Block::size, a))
+          return found;
+        continue;
+      }
+      const auto matches = ~Block::mismatches(Block::fold(block), needle) &
+                           Block::full_mask;
+      if (matches != 0U)
+        return s + i + Block::first(matches);
+    }
+#endif
+    const auto folded = fold(a);
+    for (; i < n; ++i) {
+      if (is_ascii(s[i]) ? fold(s[i]) == folded : ci_char_traits::eq(s[i], a))
+        return s + i;
+    }
+    return nullptr;
+  }
+
+  // length() is inherited from std::char_traits<char>. Finding the terminating
+  // null character does not depend on case and the Standard Library forwards
+  // it to the (already vectorized) strlen of the C library.
+
+private:
+#if defined(__AVX2__)
+  // Processes 32 characters at once.
+  struct Block {
+    using Reg = __m256i;
+    static constexpr std::size_t size = 32U;
+    static constexpr std::uint32_t full_mask = 0xFFFFFFFFU;
+    static Reg load(const char *p) {
+      return _mm256_loadu_si256(reinterpret_cast<const Reg *>(p));
+    }
+    static Reg splat(char ch) { return _mm256_set1_epi8(ch); }
+    static bool any_non_ascii(Reg a, Reg b) {
+      return _mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0;
+    }
+    // Same as fold() above. ASCII characters are non-negative as signed
+    // bytes, so signed comparisons check the bounds.
+    static Reg fold(Reg a) {
+      const auto is_lower =
+          _mm256_and_si256(_mm256_cmpgt_epi8(a, _mm256_set1_epi8('a' - 1)),
+                           _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), a));
+      return _mm256_xor_si256(
+          a, _mm256_and_si256(is_lower, _mm256_set1_epi8(0x20)));
+    }
+    // Bit i is set iff the characters at position i differ.
+    static std::uint32_t mismatches(Reg a, Reg b) {
+      return ~static_cast<std::uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+    static std::size_t first(std::uint32_t mask) {
+      return static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  };
+#elif defined(__SSE2__)
+  // Processes 16 characters at once.
+  struct Block {
+    using Reg = __m128i;
+    static constexpr std::size_t size = 16U;
+    static constexpr std::uint32_t full_mask = 0xFFFFU;
+    static Reg load(const char *p) {
+      return _mm_loadu_si128(reinterpret_cast<const Reg *>(p));
+    }
+    static Reg splat(char ch) { return _mm_set1_epi8(ch); }
+    static bool any_non_ascii(Reg a, Reg b) {
+      return _mm_movemask_epi8(_mm_or_si128(a, b)) != 0;
+    }
+    static Reg fold(Reg a) {
+      const auto is_lower =
+          _mm_and_si128(_mm_cmpgt_epi8(a, _mm_set1_epi8('a' - 1)),
+                        _mm_cmplt_epi8(a, _mm_set1_epi8('z' + 1)));
+      return _mm_xor_si128(a, _mm_and_si128(is_lower, _mm_set1_epi8(0x20)));
+    }
+    static std::uint32_t mismatches(Reg a, Reg b) {
+      return ~static_cast<std::uint32_t>(
+                 _mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) &
+             full_mask;
+    }
+    static std::size_t first(std::uint32_t mask) {
+      return static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  };
+#endif
+};
+using ascii_ci_string = std::basic_string<char, ascii_ci_char_traits>;
+
+// Case-insensitive hashing
+
+// A hash that is consistent with case-insensitive equality needs to fold case
+// before mixing the characters in. Converting to a lower case string first
+// would allocate, so we fold eight characters at a time inside the hash
+// function instead. Only ASCII letters are folded which makes the hash
+// consistent with ci_char_traits in the default "C" locale and with
+// ascii_ci_char_traits.
+
+// Folds all ASCII lower case letters in the eight bytes of word to upper case
+// (SIMD within a register). Adding 0x80 - 'a' to a byte with its high bit
+// cleared sets the high bit iff the byte is at least 'a', so the high bits mark
+// the bytes in [a, z] that are not part of a multi-byte UTF-8 sequence.
+constexpr std::uint64_t ci_fold_word(std::uint64_t word) noexcept {
+  constexpr auto ones = 0x0101010101010101ULL;
+  constexpr auto high_bits = 0x8080808080808080ULL;
+  const auto low_bits = word & ~high_bits;
+  const auto at_least_a = low_bits + ones * (0x80U - 'a');
+  const auto above_z = low_bits + ones * (0x80U - 'z' - 1U);
+  const auto is_lower = at_least_a & ~above_z & ~word & high_bits;
+  return word ^ (is_lower >> 2U);
+}
+
+inline std::uint64_t ci_mix(std::uint64_t a, std::uint64_t b) noexcept {
+  return multiply_fold(a, b);
+}
+
+inline std::uint64_t ci_read_word(const char *p) noexcept {
+  std::uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Reads the remaining 0 to 7 characters without reading past the end. Empty
+// views may have a null data(), which memcpy must not get even for n == 0.
+inline std::uint64_t ci_read_tail(const char *p, std::size_t n) noexcept {
+  std::uint64_t word = 0U;
+  if (n == 0U)
+    return word;
+  std::memcpy(&word, p, n);
+  return word;
+}
+
+// wyhash-style hash over the case-folded characters of [s, s + n).
+inline std::size_t ci_hash_bytes(const char *s, std::size_t n,
+                                 std::uint64_t seed = 0U) noexcept {
+  constexpr auto p0 = 0xa0761d6478bd642fULL;
+  constexpr auto p1 = 0xe7037ed1a0b428dbULL;
+  constexpr auto p2 = 0x8ebc6af09c88c6e3ULL;
+  auto state = seed ^ ci_mix(seed ^ p0, p1);
+  auto remaining = n;
+  for (; remaining >= 16U; remaining -= 16U, s += 16U) {
+    state = ci_mix(ci_fold_word(ci_read_word(s)) ^ p1,
+                   ci_fold_word(ci_read_word(s + 8U)) ^ state);
+  }
+  auto a = std::uint64_t{0U};
+  auto b = std::uint64_t{0U};
+  if (remaining >= 8U) {
+    a = ci_fold_word(ci_read_word(s));
+    b = ci_fold_word(ci_read_tail(s + 8U, remaining - 8U));
+  } else {
+    a = ci_fold_word(ci_read_tail(s, remaining));
+  }
+  const auto length = static_cast<std::uint64_t>(n);
+  return static_cast<std::size_t>(
+      ci_mix(p1 ^ length, ci_mix(a ^ p1, b ^ state ^ p2)));
+}
+
+class CIString;
+
+// Transparent hash functor. It hashes all case-insensitive string types and
+// std::string_view alike, which enables lookups without temporary strings.
+struct ci_hash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view s) const noexcept {
+    return ci_hash_bytes(s.data(), s.size());
+  }
+  std::size_t operator()(const char *s) const noexcept {
+    return (*this)(std::string_view{s});
+  }
+  std::size_t operator()(const ci_string &s) const noexcept {
+    return ci_hash_bytes(s.data(), s.size());
+  }
+  std::size_t operator()(const ascii_ci_string &s) const noexcept {
+    return ci_hash_bytes(s.data(), s.size());
+  }
+  std::size_t operator()(const CIStringView &s) const noexcept {
+    return ci_hash_bytes(s.data(), s.size());
+  }
+  std::size_t operator()(const CIString &s) const noexcept;
+};
+
+// Owning case-insensitive string
+
+// CIString owns its characters and stores strings of up to LocalCapacity
+// characters inline (small-string optimization), so short keys never allocate.
+// The length and the case-folded hash are computed once on construction:
+// comparisons of strings with different lengths or hashes return immediately
+// and the remaining ones compare in SIMD blocks. Like to_lower(), only ASCII
+// letters are folded, which keeps equality consistent with ci_hash.
+class CIString {
+public:
+  static constexpr std::size_t LocalCapacity = 15U;
+
+  // Starts out as the empty local string without going through a view, whose
+  // data() would be a null pointer.
+  CIString() noexcept {
+    m_local[0] = '\0';
+    m_hash = ci_hash_bytes(m_local, 0U);
+  }
+  CIString(const char *str) : CIString{std::string_view{str}} {}
+  CIString(CIStringView str)
+      : CIString{std::string_view{str.data(), str.size()}} {}
+  explicit CIString(std::string_view str)
+      : m_size{str.size()}, m_hash{ci_hash_bytes(str.data(), str.size())} {
+    auto *data = is_local() ? m_local : (m_heap = new char[m_size + 1U]);
+    if (m_size != 0U)
+      std::memcpy(data, str.data(), m_size);
+    data[m_size] = '\0';
+  }
+
+  CIString(const CIString &other)
+      : CIString{std::string_view{other.data(), other.size()}} {}
+  CIString(CIString &&other) noexcept { steal(other); }
+
+  CIString &operator=(const CIString &other) {
+    if (this != &other) {
+      auto tmp = CIString{other};
+      release();
+      steal(tmp);
+    }
+    return *this;
+  }
+  CIString &operator=(CIString &&other) noexcept {
+    if (this != &other) {
+      release();
+      steal(other);
+    }
+    return *this;
+  }
+
+  ~CIString() { release(); }
+
+  const char *data() const noexcept { return is_local() ? m_local : m_heap; }
+  const char *c_str() const noexcept { return data(); }
+  std::size_t size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0U; }
+  std::size_t hash() const noexcept { return m_hash; }
+
+  operator CIStringView() const noexcept { return {data(), size()}; }
+
+  friend bool operator==(const CIString &lhs, const CIString &rhs) noexcept {
+    return lhs.m_size == rhs.m_size && lhs.m_hash == rhs.m_hash &&
+           ascii_ci_char_traits::equal_ascii(lhs.data(), rhs.data(),
+                                             lhs.m_size);
+  }
+  friend bool operator!=(const CIString &lhs, const CIString &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+private:
+  bool is_local() const noexcept { return m_size <= LocalCapacity; }
+
+  void release() noexcept {
+    if (!is_local())
+      delete[] m_heap;
+  }
+
+  // Takes over the characters of other and leaves it empty.
+  void steal(CIString &other) noexcept {
+    m_size = other.m_size;
+    m_hash = other.m_hash;
+    if (is_local())
+      std::memcpy(m_local, other.m_local, m_size + 1U);
+    else
+      m_heap = other.m_heap;
+    other.m_size = 0U;
+    other.m_hash = ci_hash_bytes(other.m_local, 0U);
+    other.m_local[0] = '\0';
+  }
+
+  std::size_t m_size{0U};
+  std::size_t m_hash{0U};
+  union {
+    char m_local[LocalCapacity + 1U];
+    char *m_heap;
+  };
+};
+
+// The cached hash equals ci_hash of the characters.
+inline std::size_t ci_hash::operator()(const CIString &s) const noexcept {
+  return s.hash();
+}
+
+// Specializations that make the case-insensitive string types usable as keys
+// of the unordered Standard Library containers.
+namespace std {
+template <> struct hash<ci_string> : ci_hash {};
+template <> struct hash<ascii_ci_string> : ci_hash {};
+template <> struct hash<CIString> : ci_hash {};
+} // namespace std
+
+// Flat case-insensitive hash map
+
+// Open-addressing hash map with linear probing keyed by case-insensitive
+// strings. All entries live in a single array, so a lookup touches one or two
+// cache lines instead of chasing the node pointers of std::unordered_map.
+// Lookups, insertions and erasure accept any string type that can be viewed as
+// a std::string_view, so no temporary key strings are created.
+template <typename Value> class CIFlatMap {
+public:
+  using Key = ascii_ci_string;
+
+  CIFlatMap() = default;
+  explicit CIFlatMap(std::size_t capacity) { reserve(capacity); }
+
+  std::size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0U; }
+
+  void clear() noexcept {
+    for (auto &slot : slots)
+      slot.entry.reset();
+    count = 0U;
+  }
+
+  // Makes room for at least capacity entries without rehashing.
+  void reserve(std::size_t capacity) {
+    auto slot_count = std::size_t{MinSlots};
+    while (slot_count * MaxLoadNum < capacity * MaxLoadDen)
+      slot_count *= 2U;
+    if (slot_count > slots.size())
+      rehash(slot_count);
+  }
+
+  template <typename K> Value *find(const K &key) noexcept {
+    const auto view = key_view(key);
+    const auto index = find_index(view, ci_hash{}(view));
+    return index == npos ? nullptr : &slots[index].entry->second;
+  }
+  template <typename K> const Value *find(const K &key) const noexcept {
+    return const_cast<CIFlatMap *>(this)->find(key);
+  }
+  template <typename K> bool contains(const K &key) const noexcept {
+    return find(key) != nullptr;
+  }
+
+  // Inserts Value(args...) iff there is no entry for key yet. Returns the
+  // (possibly existing) value and whether it was inserted.
+  template <typename K, typename... Args>
+  std::pair<Value *, bool> try_emplace(const K &key, Args &&...args) {
+    const auto view = key_view(key);
+    const auto hash = ci_hash{}(view);
+    if (const auto index = find_index(view, hash); index != npos)
+      return {&slots[index].entry->second, false};
+    if ((count + 1U) * MaxLoadDen > slots.size() * MaxLoadNum)
+      rehash(slots.empty() ? MinSlots : 2U * slots.size());
+    auto index = hash & (slots.size() - 1U);
+    while (slots[index].entry)
+      index = (index + 1U) & (slots.size() - 1U);
+    slots[index].hash = hash;
+    slots[index].entry.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(view.data(), view.size()),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    ++count;
+    return {&slots[index].entry->second, true};
+  }
+
+  template <typename K> Value &operator[](const K &key) {
+    return *try_emplace(key).first;
+  }
+
+  // Removes the entry for key. Instead of leaving a tombstone, the following
+  // entries of the probe sequence are shifted back into the gap so that later
+  // lookups remain short.
+  template <typename K> bool erase(const K &key) {
+    const auto view = key_view(key);
+    auto gap = find_index(view, ci_hash{}(view));
+    if (gap == npos)
+      return false;
+    const auto mask = slots.size() - 1U;
+    for (auto index = (gap + 1U) & mask; slots[index].entry;
+         index = (index + 1U) & mask) {
+      const auto home = slots[index].hash & mask;
+      // Move the entry iff its home slot does not lie in (gap, index].
+      const auto distance_to_index = (index - home) & mask;
+      const auto distance_to_gap = (gap - home) & mask;
+      if (distance_to_gap < distance_to_index) {
+        slots[gap].hash = slots[index].hash;
+        slots[gap].entry = std::move(slots[index].entry);
+        gap = index;
+      }
+    }
+    slots[gap].entry.reset();
+    --count;
+    return true;
+  }
+
+  // Visits all entries as f(key, value) in unspecified order.
+  template <typename F> void for_each(F &&f) const {
+    for (const auto &slot : slots) {
+      if (slot.entry)
+        f(slot.entry->first, slot.entry->second);
+    }
+  }
+
+private:
+  struct Slot {
+    std::size_t hash{0U};
+    std::optional<std::pair<Key, Value>> entry{};
+  };
+
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+  static constexpr std::size_t MinSlots = 16U;
+  // Maximum load factor of 3/4 keeps probe sequences short.
+  static constexpr std::size_t MaxLoadNum = 3U;
+  static constexpr std::size_t MaxLoadDen = 4U;
+
+  static std::string_view key_view(std::string_view key) noexcept {
+    return key;
+  }
+  static std::string_view key_view(const char *key) noexcept { return key; }
+  static std::string_view key_view(const ci_string &key) noexcept {
+    return {key.data(), key.size()};
+  }
+  static std::string_view key_view(const ascii_ci_string &key) noexcept {
+    return {key.data(), key.size()};
+  }
+  static std::string_view key_view(const CIString &key) noexcept {
+    return {key.data(), key.size()};
+  }
+  static std::string_view key_view(const CIStringView &key) noexcept {
+    return {key.data(), key.size()};
+  }
+
+  std::size_t find_index(std::string_view key,
+                         std::size_t hash) const noexcept {
+    if (slots.empty())
+      return npos;
+    const auto mask = slots.size() - 1U;
+    for (auto index = hash & mask; slots[index].entry;
+         index = (index + 1U) & mask) {
+      // Comparing the full hash first skips most string comparisons.
+      const auto &slot = slots[index];
+      if (slot.hash == hash && slot.entry->first.size() == key.size() &&
+          ascii_ci_char_traits::compare(slot.entry->first.data(), key.data(),
+                                        key.size()) == 0)
+        return index;
+    }
+    return npos;
+  }
+
+  void rehash(std::size_t slot_count) {
+    auto old = std::exchange(slots, std::vector<Slot>(slot_count));
+    const auto mask = slot_count - 1U;
+    for (auto &slot : old) {
+      if (!slot.entry)
+        continue;
+      auto index = slot.hash & mask;
+      while (slots[index].entry)
+        index = (index + 1U) & mask;
+      slots[index].hash = slot.hash;
+      slots[index].entry = std::move(slot.entry);
+    }
+  }
+
+  std::vector<Slot> slots{};
+  std::size_t count{0U};
+};
+
+#endif // !EXCEPTIONAL_CPP_CASE_INSENSITIVE_STRING
@@ -0,0 +1,33 @@
+#ifndef EXCEPTIONAL_CPP_MULTIPLY_FOLD
+#define EXCEPTIONAL_CPP_MULTIPLY_FOLD
+
+#include <cstdint>
+
+// Multiplies two 64-bit words to 128 bits and folds the halves with xor, the
+// mixing primitive of wyhash. Every input bit affects the whole result. The
+// compiler's 128-bit integers are an extension, which __extension__ keeps
+// -Wpedantic from warning about. Elsewhere the product is assembled from
+// 32-bit halves, so the result is the same on every platform.
+inline std::uint64_t multiply_fold(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 U128;
+  const auto product = static_cast<U128>(a) * b;
+  return static_cast<std::uint64_t>(product) ^
+         static_cast<std::uint64_t>(product >> 64U);
+#else
+  constexpr auto low_mask = 0xFFFFFFFFULL;
+  const auto a_low = a & low_mask;
+  const auto a_high = a >> 32U;
+  const auto b_low = b & low_mask;
+  const auto b_high = b >> 32U;
+  const auto low_low = a_low * b_low;
+  const auto low_high = a_low * b_high;
+  const auto high_low = a_high * b_low;
+  const auto cross = (low_low >> 32U) + (low_high & low_mask) + high_low;
+  const auto high = a_high * b_high + (low_high >> 32U) + (cross >> 32U);
+  const auto low = (cross << 32U) | (low_low & low_mask);
+  return low ^ high;
+#endif
+}
+
+#endif